@@ -1,8 +1,14 @@
+#define _POSIX_C_SOURCE 199309L
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "bloom.h"
 
 #define MIN_DEGREE 3  // Minimum degree (minimum number of keys is t-1)
+#define FILTER_FPR 0.01         // Target false-positive rate of the Bloom filter
+#define FILTER_MIN_CAPACITY 1024
 
 // B-tree node structure
 typedef struct BTreeNode {
@@ -23,7 +29,7 @@ void insert(BTreeNode **root, int key, int t);
 void insertNonFull(BTreeNode *node, int key);
 void splitChild(BTreeNode *parent, int i, BTreeNode *fullChild);
 void delete(BTreeNode **root, int key);
-void deleteFromNode(BTreeNode *node, int key);
+bool deleteFromNode(BTreeNode *node, int key);
 int getPredecessor(BTreeNode *node, int idx);
 int getSuccessor(BTreeNode *node, int idx);
 void fill(BTreeNode *node, int idx);
@@ -31,6 +37,19 @@ void borrowFromPrev(BTreeNode *node, int idx);
 void borrowFromNext(BTreeNode *node, int idx);
 void merge(BTreeNode *node, int idx);
 void freeTree(BTreeNode *root);
+int countKeys(BTreeNode *root);
+void enableFilter(BTreeNode *root);
+void disableFilter(void);
+void rebuildFilter(BTreeNode *root);
+BTreeNode* searchFiltered(BTreeNode *root, int key);
+
+// Optional Bloom filter in front of search(): absent keys are usually
+// rejected without descending the tree. Inserts keep it in sync; deletes
+// leave their bits set (it stays correct but grows less selective), so
+// 'filterStale' counts them until rebuildFilter() is called.
+BloomFilter keyFilter;
+bool filterEnabled = false;
+int filterStale = 0;
 
 // Create a new B-tree node
 BTreeNode* createNode(int t, bool leaf) {
@@ -116,6 +135,57 @@ BTreeNode* search(BTreeNode *root, int key) {
     return search(root->children[i], key);
 }
 
+// Search with the Bloom filter (if enabled) answering most misses up front
+BTreeNode* searchFiltered(BTreeNode *root, int key) {
+    if (filterEnabled && !bloomMayContain(&keyFilter, key))
+        return NULL;
+    return search(root, key);
+}
+
+// Count the keys in the tree
+int countKeys(BTreeNode *root) {
+    if (root == NULL)
+        return 0;
+    int total = root->n;
+    if (!root->leaf) {
+        for (int i = 0; i <= root->n; i++)
+            total += countKeys(root->children[i]);
+    }
+    return total;
+}
+
+// Add every key of the tree to the filter
+static void addTreeToFilter(BTreeNode *root) {
+    if (root == NULL)
+        return;
+    for (int i = 0; i < root->n; i++)
+        bloomAdd(&keyFilter, root->keys[i]);
+    if (!root->leaf) {
+        for (int i = 0; i <= root->n; i++)
+            addTreeToFilter(root->children[i]);
+    }
+}
+
+// Rebuild the filter from the tree, sized for twice the current key count
+void rebuildFilter(BTreeNode *root) {
+    int keys = countKeys(root);
+    int capacity = 2 * keys > FILTER_MIN_CAPACITY ? 2 * keys : FILTER_MIN_CAPACITY;
+    bloomFree(&keyFilter);
+    bloomInit(&keyFilter, (uint32_t)capacity, FILTER_FPR);
+    addTreeToFilter(root);
+    filterStale = 0;
+}
+
+void enableFilter(BTreeNode *root) {
+    filterEnabled = true;
+    rebuildFilter(root);
+}
+
+void disableFilter(void) {
+    filterEnabled = false;
+    bloomFree(&keyFilter);
+}
+
 // Insert a key into the B-tree
 void insert(BTreeNode **root, int key, int t) {
     if (*root == NULL) {
@@ -138,6 +208,14 @@ void insert(BTreeNode **root, int key, int t) {
             insertNonFull(*root, key);
         }
     }
+
+    // Keep the filter in sync; past its capacity, rebuild it larger
+    if (filterEnabled) {
+        if (keyFilter.count >= keyFilter.capacity)
+            rebuildFilter(*root);
+        else
+            bloomAdd(&keyFilter, key);
+    }
 }
 
 // Insert into a node that is not full
@@ -200,7 +278,8 @@ void delete(BTreeNode **root, int key) {
         return;
     }
     
-    deleteFromNode(*root, key);
+    if (deleteFromNode(*root, key) && filterEnabled)
+        filterStale++;
     
     if ((*root)->n == 0) {
         BTreeNode *tmp = *root;
@@ -214,8 +293,8 @@ void delete(BTreeNode **root, int key) {
     }
 }
 
-// Delete from a node
-void deleteFromNode(BTreeNode *node, int key) {
+// Delete from a node; returns true if the key was found and removed
+bool deleteFromNode(BTreeNode *node, int key) {
     int idx = 0;
     while (idx < node->n && node->keys[idx] < key)
         idx++;
@@ -225,24 +304,25 @@ void deleteFromNode(BTreeNode *node, int key) {
             for (int i = idx + 1; i < node->n; i++)
                 node->keys[i - 1] = node->keys[i];
             node->n--;
+            return true;
+        }
+        if (node->children[idx]->n >= node->t) {
+            int pred = getPredecessor(node, idx);
+            node->keys[idx] = pred;
+            deleteFromNode(node->children[idx], pred);
+        } else if (node->children[idx + 1]->n >= node->t) {
+            int succ = getSuccessor(node, idx);
+            node->keys[idx] = succ;
+            deleteFromNode(node->children[idx + 1], succ);
         } else {
-            if (node->children[idx]->n >= node->t) {
-                int pred = getPredecessor(node, idx);
-                node->keys[idx] = pred;
-                deleteFromNode(node->children[idx], pred);
-            } else if (node->children[idx + 1]->n >= node->t) {
-                int succ = getSuccessor(node, idx);
-                node->keys[idx] = succ;
-                deleteFromNode(node->children[idx + 1], succ);
-            } else {
-                merge(node, idx);
-                deleteFromNode(node->children[idx], key);
-            }
+            merge(node, idx);
+            deleteFromNode(node->children[idx], key);
         }
+        return true;
     } else {
         if (node->leaf) {
             printf("Key %d not found in tree\n", key);
-            return;
+            return false;
         }
         
         bool flag = (idx == node->n);
@@ -251,9 +331,8 @@ void deleteFromNode(BTreeNode *node, int key) {
             fill(node, idx);
         
         if (flag && idx > node->n)
-            deleteFromNode(node->children[idx - 1], key);
-        else
-            deleteFromNode(node->children[idx], key);
+            return deleteFromNode(node->children[idx - 1], key);
+        return deleteFromNode(node->children[idx], key);
     }
 }
 
@@ -386,20 +465,101 @@ void displayMenu() {
     printf("4. Display tree (In-order Traversal)\n");
     printf("5. Display tree structure (Hierarchical)\n");
     printf("6. Exit\n");
+    printf("7. Rebuild Bloom filter (after deletions)\n");
     printf("=================================\n");
     printf("Enter your choice: ");
 }
 
+// --- Benchmark ---
+
+static unsigned long long rngState = 88172645463325252ULL;
+static int nextKey(void) {
+    rngState ^= rngState << 13; rngState ^= rngState >> 7; rngState ^= rngState << 17;
+    return (int)(rngState & 0x7fffffff);
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Compare search() against searchFiltered() at miss ratios from 0% to 99%
+void runBenchmark(int numKeys, int lookups) {
+    BTreeNode *root = NULL;
+    int *keys = (int*)malloc(sizeof(int) * numKeys);
+    int *probe = (int*)malloc(sizeof(int) * lookups);
+
+    for (int i = 0; i < numKeys; i++) {
+        keys[i] = nextKey();
+        insert(&root, keys[i], MIN_DEGREE);
+    }
+    enableFilter(root);
+
+    printf("--- B-Tree Bloom Filter Benchmark (t = %d, %d keys, %d lookups, FPR %.2f) ---\n",
+           MIN_DEGREE, numKeys, lookups, FILTER_FPR);
+    printf("  miss ratio   search (Mlookups/s)   filtered (Mlookups/s)   speedup   observed FPR\n");
+
+    int missPercents[] = {0, 25, 50, 75, 90, 99};
+    for (int m = 0; m < (int)(sizeof(missPercents) / sizeof(missPercents[0])); m++) {
+        int absent = 0, falsePositives = 0;
+        for (int i = 0; i < lookups; i++) {
+            if ((int)(nextKey() % 100) < missPercents[m]) {
+                do { probe[i] = nextKey(); } while (search(root, probe[i]) != NULL);
+                absent++;
+                falsePositives += bloomMayContain(&keyFilter, probe[i]);
+            } else {
+                probe[i] = keys[nextKey() % numKeys];
+            }
+        }
+
+        double start = nowSeconds();
+        int hits = 0;
+        for (int i = 0; i < lookups; i++)
+            hits += search(root, probe[i]) != NULL;
+        double plain = nowSeconds() - start;
+
+        start = nowSeconds();
+        int filteredHits = 0;
+        for (int i = 0; i < lookups; i++)
+            filteredHits += searchFiltered(root, probe[i]) != NULL;
+        double filtered = nowSeconds() - start;
+
+        printf("  %8d%%   %19.2f   %21.2f   %6.2fx   %10.4f%s\n",
+               missPercents[m], lookups / plain / 1e6, lookups / filtered / 1e6, plain / filtered,
+               absent ? (double)falsePositives / absent : 0.0,
+               hits == filteredHits ? "" : "  (MISMATCH)");
+    }
+
+    disableFilter();
+    freeTree(root);
+    free(probe);
+    free(keys);
+}
+
 // Main function with menu-driven interface
-int main() {
+// Build:  gcc -O2 -march=native b_tree.c -o b_tree -lm
+// Usage: ./b_tree                        (menu)
+//        ./b_tree bench [keys] [lookups]
+int main(int argc, char *argv[]) {
     BTreeNode *root = NULL;
     int t = MIN_DEGREE;
     int choice, key;
     BTreeNode *result;
     
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        int numKeys = argc > 2 ? atoi(argv[2]) : 1000000;
+        int lookups = argc > 3 ? atoi(argv[3]) : 2000000;
+        runBenchmark(numKeys, lookups);
+        return 0;
+    }
+    
+    enableFilter(root);
+    
     printf("\n*** B-TREE IMPLEMENTATION ***\n");
     printf("Minimum Degree (t) = %d\n", t);
     printf("Each node can have %d to %d keys\n", t-1, 2*t-1);
+    printf("Bloom filter in front of search: ON (target FPR %.2f)\n", FILTER_FPR);
     
     while (1) {
         displayMenu();
@@ -448,7 +608,7 @@ int main() {
                     while (getchar() != '\n');
                     break;
                 }
-                result = search(root, key);
+                result = searchFiltered(root, key);
                 if (result != NULL)
                     printf("Key %d FOUND in the tree!\n", key);
                 else
@@ -472,11 +632,18 @@ int main() {
             case 6:
                 printf("\nFreeing memory and exiting...\n");
                 freeTree(root);
+                disableFilter();
                 printf("Goodbye!\n");
                 return 0;
                 
+            case 7:
+                printf("\nRebuilding Bloom filter (%d stale deletion(s))...\n", filterStale);
+                rebuildFilter(root);
+                printf("Filter now holds %u keys.\n", keyFilter.count);
+                break;
+                
             default:
-                printf("\nInvalid choice! Please enter a number between 1 and 6.\n");
+                printf("\nInvalid choice! Please enter a number between 1 and 7.\n");
         }
     }
     
@@ -0,0 +1,133 @@
+#ifndef BLOOM_H
+#define BLOOM_H
+
+// Split-block Bloom filter for int keys, shared by b_tree.c and hashing.c.
+//
+// The filter is an array of 256-bit blocks (8 x 32-bit words, 32-byte
+// aligned, so a block never crosses a cache line). A key selects one block
+// and sets exactly one bit in each of its 8 words, so add and query touch a
+// single cache line. With AVX2 (-mavx2 or -march=native) the 8 bit positions
+// are computed and tested in one vector; otherwise a scalar loop does the same.
+//
+// Bloom filters cannot delete. Callers keep the filter in sync on insert and
+// rebuild it from their own data when deletions have made it stale.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#define BLOOM_WORDS 8   // 32-bit words per block (256 bits)
+
+typedef struct {
+    uint32_t (*blocks)[BLOOM_WORDS];
+    uint32_t numBlocks;
+    uint32_t capacity;      // Keys the filter was sized for
+    uint32_t count;         // Keys added since the last clear
+    double targetFpr;
+} BloomFilter;
+
+// Odd multipliers that turn one 32-bit hash into 8 bit positions
+static const uint32_t bloomSalts[BLOOM_WORDS] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
+static inline uint64_t bloomHash(int key) {
+    uint64_t x = (uint64_t)(uint32_t)key * 0x9e3779b97f4a7c15ULL;
+    x ^= x >> 32; x *= 0xd6e8feb86659fd93ULL;
+    x ^= x >> 32;
+    return x;
+}
+
+// Upper 32 hash bits pick the block (multiply-shift, no modulo)
+static inline uint32_t bloomBlock(const BloomFilter *f, uint64_t h) {
+    return (uint32_t)(((h >> 32) * (uint64_t)f->numBlocks) >> 32);
+}
+
+/**
+ * Expected false-positive rate of a split-block filter holding 'keysPerBlock'
+ * keys per block on average: block loads are Poisson distributed, and a key
+ * in a block with i other keys is a false positive when all 8 of its bits
+ * are already set.
+ */
+static inline double bloomExpectedFpr(double keysPerBlock) {
+    double fpr = 0.0, p = exp(-keysPerBlock); // P(load = 0)
+    for (int i = 0; i < 1000; i++) {
+        fpr += p * pow(1.0 - pow(1.0 - 1.0 / 32.0, i), BLOOM_WORDS);
+        p *= keysPerBlock / (i + 1);
+        if (i > keysPerBlock && p < 1e-12) break;
+    }
+    return fpr;
+}
+
+// Sizes the filter for 'expectedKeys' keys at the given false-positive rate
+static inline void bloomInit(BloomFilter *f, uint32_t expectedKeys, double targetFpr) {
+    if (expectedKeys == 0) expectedKeys = 1;
+    double keysPerBlock = 256.0;
+    while (keysPerBlock > 0.5 && bloomExpectedFpr(keysPerBlock) > targetFpr)
+        keysPerBlock *= 0.95;
+
+    f->numBlocks = (uint32_t)ceil(expectedKeys / keysPerBlock);
+    if (f->numBlocks == 0) f->numBlocks = 1;
+    f->capacity = expectedKeys;
+    f->count = 0;
+    f->targetFpr = targetFpr;
+    f->blocks = aligned_alloc(32, (size_t)f->numBlocks * sizeof(*f->blocks));
+    if (f->blocks == NULL) {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
+    memset(f->blocks, 0, (size_t)f->numBlocks * sizeof(*f->blocks));
+}
+
+static inline void bloomFree(BloomFilter *f) {
+    free(f->blocks);
+    f->blocks = NULL;
+    f->numBlocks = 0;
+}
+
+static inline void bloomClear(BloomFilter *f) {
+    memset(f->blocks, 0, (size_t)f->numBlocks * sizeof(*f->blocks));
+    f->count = 0;
+}
+
+static inline void bloomAdd(BloomFilter *f, int key) {
+    uint64_t h = bloomHash(key);
+    uint32_t *block = f->blocks[bloomBlock(f, h)];
+#ifdef __AVX2__
+    __m256i salts = _mm256_loadu_si256((const __m256i *)bloomSalts);
+    __m256i bits = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32((int)(uint32_t)h), salts), 27);
+    __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), bits);
+    __m256i cur = _mm256_load_si256((const __m256i *)block);
+    _mm256_store_si256((__m256i *)block, _mm256_or_si256(cur, mask));
+#else
+    for (int i = 0; i < BLOOM_WORDS; i++)
+        block[i] |= 1U << (((uint32_t)h * bloomSalts[i]) >> 27);
+#endif
+    f->count++;
+}
+
+// Returns 0 if the key is definitely absent, 1 if it may be present
+static inline int bloomMayContain(const BloomFilter *f, int key) {
+    uint64_t h = bloomHash(key);
+    const uint32_t *block = f->blocks[bloomBlock(f, h)];
+#ifdef __AVX2__
+    __m256i salts = _mm256_loadu_si256((const __m256i *)bloomSalts);
+    __m256i bits = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32((int)(uint32_t)h), salts), 27);
+    __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), bits);
+    // testc: 1 when every bit of 'mask' is also set in the block
+    return _mm256_testc_si256(_mm256_load_si256((const __m256i *)block), mask);
+#else
+    for (int i = 0; i < BLOOM_WORDS; i++)
+        if (!(block[i] & (1U << (((uint32_t)h * bloomSalts[i]) >> 27)))) return 0;
+    return 1;
+#endif
+}
+
+#endif // BLOOM_H
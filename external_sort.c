@@ -0,0 +1,675 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// External merge sort for files of raw int64 keys that do not fit in memory.
+//
+// Stage 1 reads the input in chunks sized to the memory budget, sorts each
+// chunk in memory (LSD radix sort) and writes it out as a sorted run.
+// Stage 2 merges up to FAN_IN runs at a time through a loser tree, in as
+// many passes as needed, until one run is left.
+// Stage 3 is the I/O underneath both: every read and write goes through a
+// background I/O thread, and each stream owns two buffers, so the next block
+// is being read (or the previous one written) while the current one is
+// sorted or merged.
+
+// --- Configuration ---
+#define DEFAULT_BUDGET_MB 256
+#define DEFAULT_FAN_IN 16
+#define MIN_STREAM_BUFFER (64 * 1024)   // Merge buffers below this size cap the fan-in
+
+typedef int64_t Key;
+
+// --- Utility Functions ---
+
+static void *allocOrDie(size_t bytes) {
+    void *p = malloc(bytes);
+    if (p == NULL) {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
+    return p;
+}
+
+static int openOrDie(const char *path, int flags) {
+    int fd = open(path, flags, 0644);
+    if (fd < 0) {
+        perror(path);
+        exit(1);
+    }
+    return fd;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// --- Asynchronous I/O ---
+
+// One pread/pwrite handed to the I/O thread
+typedef struct IoRequest {
+    int fd;
+    int isWrite;
+    char *buf;
+    size_t bytes;
+    off_t offset;
+    int done;
+    struct IoRequest *next;
+} IoRequest;
+
+static pthread_t ioThread;
+static pthread_mutex_t ioLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t ioWork = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t ioDone = PTHREAD_COND_INITIALIZER;
+static IoRequest *ioHead = NULL, *ioTail = NULL;
+static int ioStopping = 0;
+
+// Transfers the whole request; a short read means end of file
+static size_t transfer(IoRequest *r) {
+    size_t total = 0;
+    while (total < r->bytes) {
+        ssize_t n = r->isWrite ? pwrite(r->fd, r->buf + total, r->bytes - total, r->offset + (off_t)total)
+                               : pread(r->fd, r->buf + total, r->bytes - total, r->offset + (off_t)total);
+        if (n < 0) {
+            perror(r->isWrite ? "pwrite" : "pread");
+            exit(1);
+        }
+        if (n == 0) break;
+        total += (size_t)n;
+    }
+    return total;
+}
+
+static void *ioLoop(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&ioLock);
+    for (;;) {
+        while (ioHead == NULL && !ioStopping)
+            pthread_cond_wait(&ioWork, &ioLock);
+        if (ioHead == NULL) break;
+        IoRequest *r = ioHead;
+        ioHead = r->next;
+        if (ioHead == NULL) ioTail = NULL;
+        pthread_mutex_unlock(&ioLock);
+
+        size_t moved = transfer(r);
+
+        pthread_mutex_lock(&ioLock);
+        r->bytes = moved;
+        r->done = 1;
+        pthread_cond_broadcast(&ioDone);
+    }
+    pthread_mutex_unlock(&ioLock);
+    return NULL;
+}
+
+void ioStart(void) {
+    ioStopping = 0;
+    pthread_create(&ioThread, NULL, ioLoop, NULL);
+}
+
+void ioStop(void) {
+    pthread_mutex_lock(&ioLock);
+    ioStopping = 1;
+    pthread_cond_signal(&ioWork);
+    pthread_mutex_unlock(&ioLock);
+    pthread_join(ioThread, NULL);
+}
+
+void ioSubmit(IoRequest *r, int fd, int isWrite, void *buf, size_t bytes, off_t offset) {
+    r->fd = fd;
+    r->isWrite = isWrite;
+    r->buf = (char *)buf;
+    r->bytes = bytes;
+    r->offset = offset;
+    r->done = 0;
+    r->next = NULL;
+    pthread_mutex_lock(&ioLock);
+    if (ioTail) ioTail->next = r;
+    else ioHead = r;
+    ioTail = r;
+    pthread_cond_signal(&ioWork);
+    pthread_mutex_unlock(&ioLock);
+}
+
+// Blocks until the request is finished; returns the bytes transferred
+size_t ioWait(IoRequest *r) {
+    pthread_mutex_lock(&ioLock);
+    while (!r->done)
+        pthread_cond_wait(&ioDone, &ioLock);
+    pthread_mutex_unlock(&ioLock);
+    return r->bytes;
+}
+
+// --- Double-Buffered Streams ---
+
+// Reads keys [start, end) of a file, one buffer ahead of the consumer
+typedef struct {
+    int fd;
+    off_t next, end;          // Byte range not yet requested
+    Key *buf[2];
+    size_t cap;               // Keys per buffer
+    IoRequest req[2];
+    int active;
+    int pending;              // A read into the inactive buffer is in flight
+    Key *cur;                 // Keys of the active buffer being consumed
+    size_t count, pos;
+} RunReader;
+
+static void readerRequest(RunReader *r, int which) {
+    size_t bytes = r->cap * sizeof(Key);
+    if ((off_t)bytes > r->end - r->next) bytes = (size_t)(r->end - r->next);
+    ioSubmit(&r->req[which], r->fd, 0, r->buf[which], bytes, r->next);
+    r->next += (off_t)bytes;
+    r->pending = 1;
+}
+
+// Switches to the buffer read in the background and requests the next one
+// into the buffer just drained. Returns 0 at the end of the range.
+static int readerRefill(RunReader *r) {
+    r->active ^= 1;
+    r->count = 0;
+    if (r->pending) {
+        r->count = ioWait(&r->req[r->active]) / sizeof(Key);
+        r->pending = 0;
+    }
+    r->cur = r->buf[r->active];
+    r->pos = 0;
+    if (r->count > 0 && r->next < r->end) readerRequest(r, r->active ^ 1);
+    return r->count > 0;
+}
+
+void readerOpen(RunReader *r, int fd, off_t start, off_t end, size_t cap) {
+    r->fd = fd;
+    r->next = start;
+    r->end = end;
+    r->cap = cap;
+    r->buf[0] = (Key *)allocOrDie(cap * sizeof(Key));
+    r->buf[1] = (Key *)allocOrDie(cap * sizeof(Key));
+    r->active = 1;
+    r->count = r->pos = 0;
+    r->pending = 0;
+    readerRequest(r, 0);
+    readerRefill(r);
+}
+
+void readerClose(RunReader *r) {
+    if (r->pending) ioWait(&r->req[r->active ^ 1]);
+    free(r->buf[0]);
+    free(r->buf[1]);
+}
+
+// Writes keys sequentially; a full buffer is written in the background
+// while the other one fills
+typedef struct {
+    int fd;
+    off_t offset;
+    Key *buf[2];
+    size_t cap, fill;
+    IoRequest req[2];
+    int busy[2];
+    int active;
+} RunWriter;
+
+void writerOpen(RunWriter *w, int fd, off_t offset, size_t cap) {
+    w->fd = fd;
+    w->offset = offset;
+    w->cap = cap;
+    w->fill = 0;
+    w->buf[0] = (Key *)allocOrDie(cap * sizeof(Key));
+    w->buf[1] = (Key *)allocOrDie(cap * sizeof(Key));
+    w->busy[0] = w->busy[1] = 0;
+    w->active = 0;
+}
+
+static void writerFlush(RunWriter *w) {
+    if (w->fill == 0) return;
+    size_t bytes = w->fill * sizeof(Key);
+    ioSubmit(&w->req[w->active], w->fd, 1, w->buf[w->active], bytes, w->offset);
+    w->busy[w->active] = 1;
+    w->offset += (off_t)bytes;
+    w->active ^= 1;
+    if (w->busy[w->active]) {
+        ioWait(&w->req[w->active]);
+        w->busy[w->active] = 0;
+    }
+    w->fill = 0;
+}
+
+static inline void writerPut(RunWriter *w, Key k) {
+    w->buf[w->active][w->fill++] = k;
+    if (w->fill == w->cap) writerFlush(w);
+}
+
+// Copies n keys into the writer, flushing each buffer as it fills
+static void writerPutAll(RunWriter *w, const Key *keys, size_t n) {
+    while (n > 0) {
+        size_t take = w->cap - w->fill < n ? w->cap - w->fill : n;
+        memcpy(w->buf[w->active] + w->fill, keys, take * sizeof(Key));
+        w->fill += take;
+        keys += take;
+        n -= take;
+        if (w->fill == w->cap) writerFlush(w);
+    }
+}
+
+// Sends what is buffered to the file and waits until every write is done
+static void writerDrain(RunWriter *w) {
+    writerFlush(w);
+    for (int i = 0; i < 2; i++)
+        if (w->busy[i]) {
+            ioWait(&w->req[i]);
+            w->busy[i] = 0;
+        }
+}
+
+// Finishes the current file (see writerDrain), so its descriptor may be
+// closed, then continues at 'offset' of 'fd'
+static void writerRetarget(RunWriter *w, int fd, off_t offset) {
+    writerDrain(w);
+    w->fd = fd;
+    w->offset = offset;
+}
+
+void writerClose(RunWriter *w) {
+    writerDrain(w);
+    free(w->buf[0]);
+    free(w->buf[1]);
+}
+
+// --- Stage 1: Run Generation ---
+
+// LSD radix sort on 8-bit digits (sign bit flipped so negatives sort
+// first). Passes where every key has the same digit are skipped. Returns
+// whichever of 'keys' and 'scratch' holds the result.
+Key *radixSort(Key *keys, Key *scratch, size_t n) {
+    size_t counts[8][256];
+    memset(counts, 0, sizeof(counts));
+    for (size_t i = 0; i < n; i++) {
+        uint64_t u = (uint64_t)keys[i] ^ (1ULL << 63);
+        for (int d = 0; d < 8; d++) counts[d][(u >> (8 * d)) & 0xff]++;
+    }
+
+    Key *from = keys, *to = scratch;
+    for (int d = 0; d < 8; d++) {
+        size_t offsets[256], sum = 0;
+        int trivial = 0;
+        for (int b = 0; b < 256; b++) {
+            if (counts[d][b] == n) trivial = 1;
+            offsets[b] = sum;
+            sum += counts[d][b];
+        }
+        if (trivial) continue;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t u = (uint64_t)from[i] ^ (1ULL << 63);
+            to[offsets[(u >> (8 * d)) & 0xff]++] = from[i];
+        }
+        Key *t = from; from = to; to = t;
+    }
+    return from;
+}
+
+// A sorted run: a key range [start, end) of a temporary file. Runs hold
+// no descriptor while they wait to be merged, so the number of runs is not
+// bounded by RLIMIT_NOFILE; only the fanIn runs being merged are open.
+typedef struct {
+    off_t start, end;
+    char path[512];
+} Run;
+
+static Run newRun(const char *prefix, int id) {
+    Run r;
+    snprintf(r.path, sizeof(r.path), "%s.run%d", prefix, id);
+    r.start = r.end = 0;
+    return r;
+}
+
+// Creates (or truncates) the run's file for writing
+static int createRun(const Run *r) {
+    return openOrDie(r->path, O_WRONLY | O_CREAT | O_TRUNC);
+}
+
+static void dropRun(Run *r) {
+    unlink(r->path);
+}
+
+/**
+ * Splits the input into sorted runs of budget / 5 bytes each. Two chunk
+ * buffers alternate on the read side: while one chunk is sorted (into the
+ * third buffer's space) the next is already being read. Sorted runs go out
+ * through one RunWriter with chunk-sized buffers that moves from run file
+ * to run file, so a run is written while the next one is read and sorted.
+ * A run's file is closed once the writer moves on, so at most one is open.
+ * Returns the run count.
+ */
+int generateRuns(int inFd, off_t inBytes, size_t budget, const char *prefix, Run **runsOut) {
+    size_t chunk = budget / 5 / sizeof(Key);
+    if (chunk == 0) chunk = 1;
+    Key *buf[2] = {(Key *)allocOrDie(chunk * sizeof(Key)), (Key *)allocOrDie(chunk * sizeof(Key))};
+    Key *scratch = (Key *)allocOrDie(chunk * sizeof(Key));
+    IoRequest req[2];
+    int pending = 0;          // A read into buf[active ^ 1] is in flight
+
+    int maxRuns = (int)((inBytes / (off_t)sizeof(Key) + (off_t)chunk - 1) / (off_t)chunk) + 1;
+    Run *runs = (Run *)allocOrDie((size_t)maxRuns * sizeof(Run));
+    int numRuns = 0;
+
+    RunWriter w;
+    writerOpen(&w, -1, 0, chunk);
+
+    off_t next = 0;
+    int active = 0;
+    size_t bytes = (size_t)((off_t)(chunk * sizeof(Key)) < inBytes ? (off_t)(chunk * sizeof(Key)) : inBytes);
+    ioSubmit(&req[active], inFd, 0, buf[active], bytes, next);
+    next += (off_t)bytes;
+
+    for (int first = 1;; first = 0) {
+        size_t n = 0;
+        if (first || pending) n = ioWait(&req[active]) / sizeof(Key);
+        pending = 0;
+        if (n == 0) break;
+        // Start reading the following chunk before sorting this one
+        if (next < inBytes) {
+            bytes = chunk * sizeof(Key);
+            if ((off_t)bytes > inBytes - next) bytes = (size_t)(inBytes - next);
+            ioSubmit(&req[active ^ 1], inFd, 0, buf[active ^ 1], bytes, next);
+            next += (off_t)bytes;
+            pending = 1;
+        }
+
+        Key *sorted = radixSort(buf[active], scratch, n);
+        runs[numRuns] = newRun(prefix, numRuns);
+        int previous = w.fd;
+        writerRetarget(&w, createRun(&runs[numRuns]), 0);
+        if (previous >= 0) close(previous);
+        writerPutAll(&w, sorted, n);
+        runs[numRuns].end = (off_t)(n * sizeof(Key));
+        numRuns++;
+
+        // The radix sort may have left its output in 'scratch'; recycle buffers
+        if (sorted == scratch) {
+            scratch = buf[active];
+            buf[active] = sorted;
+        }
+        active ^= 1;
+    }
+
+    writerClose(&w);
+    if (w.fd >= 0) close(w.fd);
+    free(buf[0]);
+    free(buf[1]);
+    free(scratch);
+    *runsOut = runs;
+    return numRuns;
+}
+
+// --- Stage 2: K-Way Merge ---
+
+/**
+ * Loser tree over k streams: internal node i (1 <= i < k) holds the loser of
+ * the match played there, tree[0] the overall winner. Replacing the winner's
+ * key replays only its leaf-to-root path, log2(k) comparisons against
+ * losers, with no sibling lookups as in a binary heap.
+ */
+typedef struct {
+    int k;
+    int *tree;
+    Key *keys;          // Current key of each stream
+    int *exhausted;     // Exhausted streams lose every match
+} LoserTree;
+
+// Does stream a beat stream b? Ties go to the lower index
+static inline int beats(const LoserTree *t, int a, int b) {
+    if (t->exhausted[a]) return 0;
+    if (t->exhausted[b]) return 1;
+    return t->keys[a] < t->keys[b] || (t->keys[a] == t->keys[b] && a < b);
+}
+
+void loserTreeBuild(LoserTree *t) {
+    int k = t->k;
+    int *winners = (int *)allocOrDie(2 * (size_t)k * sizeof(int));
+    for (int i = 0; i < k; i++) winners[k + i] = i;
+    for (int node = k - 1; node >= 1; node--) {
+        int a = winners[2 * node], b = winners[2 * node + 1];
+        int win = beats(t, a, b) ? a : b;
+        winners[node] = win;
+        t->tree[node] = win == a ? b : a;
+    }
+    t->tree[0] = k > 1 ? winners[1] : 0;
+    free(winners);
+}
+
+// Replays the path of stream i after its key changed
+static inline void loserTreeReplay(LoserTree *t, int i) {
+    int winner = i;
+    for (int node = (i + t->k) / 2; node >= 1; node /= 2) {
+        if (beats(t, t->tree[node], winner)) {
+            int loser = winner;
+            winner = t->tree[node];
+            t->tree[node] = loser;
+        }
+    }
+    t->tree[0] = winner;
+}
+
+// Merges 'count' runs into 'out' with double-buffered readers and writer;
+// the runs' files are open only for the duration of the merge
+void mergeRuns(Run *in, int count, Run *out, size_t budget) {
+    // 2 buffers per input plus 2 for the output share the budget
+    size_t cap = budget / (2 * ((size_t)count + 1)) / sizeof(Key);
+    if (cap == 0) cap = 1;
+
+    RunReader *readers = (RunReader *)allocOrDie((size_t)count * sizeof(RunReader));
+    LoserTree t;
+    t.k = count;
+    t.tree = (int *)allocOrDie((size_t)count * sizeof(int));
+    t.keys = (Key *)allocOrDie((size_t)count * sizeof(Key));
+    t.exhausted = (int *)allocOrDie((size_t)count * sizeof(int));
+    for (int i = 0; i < count; i++) {
+        readerOpen(&readers[i], openOrDie(in[i].path, O_RDONLY), in[i].start, in[i].end, cap);
+        t.exhausted[i] = readers[i].count == 0;
+        if (!t.exhausted[i]) t.keys[i] = readers[i].cur[readers[i].pos++];
+    }
+    loserTreeBuild(&t);
+
+    RunWriter w;
+    writerOpen(&w, createRun(out), out->start, cap);
+    for (;;) {
+        int i = t.tree[0];
+        if (t.exhausted[i]) break;
+        writerPut(&w, t.keys[i]);
+
+        RunReader *r = &readers[i];
+        if (r->pos < r->count || readerRefill(r)) t.keys[i] = r->cur[r->pos++];
+        else t.exhausted[i] = 1;
+        loserTreeReplay(&t, i);
+    }
+    out->end = w.offset + (off_t)(w.fill * sizeof(Key));
+    writerClose(&w);
+    close(w.fd);
+
+    for (int i = 0; i < count; i++) {
+        readerClose(&readers[i]);
+        close(readers[i].fd);
+    }
+    free(readers);
+    free(t.tree);
+    free(t.keys);
+    free(t.exhausted);
+}
+
+// --- Pipeline ---
+
+typedef struct {
+    int runs, passes;
+    int fanIn;                // Fan-in actually used
+    double runSeconds, mergeSeconds;
+} SortReport;
+
+/**
+ * Sorts the int64 keys of 'inPath' into 'outPath' using at most about
+ * 'budget' bytes of buffers, merging at most 'fanIn' runs at a time.
+ * The fan-in is lowered (to no less than 2) where the budget cannot give
+ * every merge stream two buffers of MIN_STREAM_BUFFER bytes.
+ * Temporary runs are created next to the output and removed afterwards.
+ */
+SortReport externalSort(const char *inPath, const char *outPath, size_t budget, int fanIn) {
+    SortReport report = {0, 0, 0, 0.0, 0.0};
+    size_t maxFanIn = budget / (2 * MIN_STREAM_BUFFER);
+    maxFanIn = maxFanIn > 1 ? maxFanIn - 1 : 0;       // One stream is the output
+    if ((size_t)fanIn > maxFanIn) fanIn = (int)maxFanIn;
+    if (fanIn < 2) fanIn = 2;
+    report.fanIn = fanIn;
+
+    int inFd = openOrDie(inPath, O_RDONLY);
+    struct stat st;
+    fstat(inFd, &st);
+    off_t inBytes = st.st_size - st.st_size % (off_t)sizeof(Key);
+
+    ioStart();
+    double start = nowSeconds();
+    Run *runs;
+    int numRuns = generateRuns(inFd, inBytes, budget, outPath, &runs);
+    close(inFd);
+    report.runs = numRuns;
+    report.runSeconds = nowSeconds() - start;
+
+    start = nowSeconds();
+    int nextId = numRuns;
+    while (numRuns > 1) {
+        // One pass: merge consecutive groups of fanIn runs
+        int merged = 0;
+        for (int g = 0; g < numRuns; g += fanIn) {
+            int count = numRuns - g < fanIn ? numRuns - g : fanIn;
+            Run out = newRun(outPath, nextId++);
+            mergeRuns(&runs[g], count, &out, budget);
+            for (int i = 0; i < count; i++) dropRun(&runs[g + i]);
+            runs[merged++] = out;
+        }
+        numRuns = merged;
+        report.passes++;
+    }
+    report.mergeSeconds = nowSeconds() - start;
+    ioStop();
+
+    if (numRuns == 1) {
+        if (rename(runs[0].path, outPath) != 0) {
+            perror(outPath);
+            exit(1);
+        }
+    } else {
+        close(openOrDie(outPath, O_WRONLY | O_CREAT | O_TRUNC)); // Empty input
+    }
+    free(runs);
+    return report;
+}
+
+// --- Benchmark ---
+
+static unsigned long long rngState = 88172645463325252ULL;
+static Key nextKey(void) {
+    rngState ^= rngState << 13; rngState ^= rngState >> 7; rngState ^= rngState << 17;
+    return (Key)rngState;
+}
+
+// Writes 'count' random keys; returns their wrapping sum as a checksum
+uint64_t generateFile(const char *path, size_t count) {
+    int fd = openOrDie(path, O_WRONLY | O_CREAT | O_TRUNC);
+    size_t block = 1 << 20;
+    Key *buf = (Key *)allocOrDie(block * sizeof(Key));
+    uint64_t sum = 0;
+    for (size_t done = 0; done < count;) {
+        size_t n = count - done < block ? count - done : block;
+        for (size_t i = 0; i < n; i++) {
+            buf[i] = nextKey();
+            sum += (uint64_t)buf[i];
+        }
+        if (write(fd, buf, n * sizeof(Key)) != (ssize_t)(n * sizeof(Key))) {
+            perror(path);
+            exit(1);
+        }
+        done += n;
+    }
+    free(buf);
+    close(fd);
+    return sum;
+}
+
+// Returns 1 if the file is sorted and holds 'count' keys summing to 'sum'
+int verifyFile(const char *path, size_t count, uint64_t sum) {
+    int fd = openOrDie(path, O_RDONLY);
+    size_t block = 1 << 20, seen = 0;
+    Key *buf = (Key *)allocOrDie(block * sizeof(Key));
+    Key prev = INT64_MIN;
+    uint64_t total = 0;
+    int ok = 1;
+    ssize_t got;
+    while ((got = read(fd, buf, block * sizeof(Key))) > 0) {
+        size_t n = (size_t)got / sizeof(Key);
+        for (size_t i = 0; i < n; i++) {
+            if (buf[i] < prev) ok = 0;
+            prev = buf[i];
+            total += (uint64_t)buf[i];
+        }
+        seen += n;
+    }
+    free(buf);
+    close(fd);
+    return ok && seen == count && total == sum;
+}
+
+void runBenchmark(size_t dataMB, size_t budgetMB, int fanIn, const char *dir) {
+    char inPath[512], outPath[512];
+    snprintf(inPath, sizeof(inPath), "%s/external_sort.in", dir);
+    snprintf(outPath, sizeof(outPath), "%s/external_sort.out", dir);
+    size_t count = dataMB * 1048576 / sizeof(Key);
+
+    printf("--- External sort: %zu MB of int64 keys, %zu MB budget, fan-in %d ---\n", dataMB, budgetMB, fanIn);
+    uint64_t sum = generateFile(inPath, count);
+    SortReport r = externalSort(inPath, outPath, budgetMB * 1048576, fanIn);
+    double total = r.runSeconds + r.mergeSeconds;
+    if (r.fanIn != fanIn) printf("  fan-in lowered to %d to fit the budget\n", r.fanIn);
+    printf("  run generation : %8.2f s  %8.1f MB/s  (%d runs)\n", r.runSeconds, dataMB / r.runSeconds, r.runs);
+    printf("  merge          : %8.2f s  %8.1f MB/s  (%d passes, %.1f MB/s per pass)\n", r.mergeSeconds,
+           r.passes ? dataMB / r.mergeSeconds : 0.0, r.passes,
+           r.passes ? dataMB * r.passes / r.mergeSeconds : 0.0);
+    printf("  total          : %8.2f s  %8.1f MB/s\n", total, dataMB / total);
+    printf("  output sorted  : %s\n", verifyFile(outPath, count, sum) ? "yes" : "NO");
+    unlink(inPath);
+    unlink(outPath);
+}
+
+// --- Main Program ---
+// Build:  gcc -O2 -march=native external_sort.c -o external_sort -pthread
+// Usage: ./external_sort <input> <output> [budget MB] [fan-in]
+//        ./external_sort bench [data MB] [budget MB] [fan-in] [dir]
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        runBenchmark(argc > 2 ? (size_t)atol(argv[2]) : 1024,
+                     argc > 3 ? (size_t)atol(argv[3]) : 64,
+                     argc > 4 ? atoi(argv[4]) : 8,
+                     argc > 5 ? argv[5] : ".");
+        return 0;
+    }
+    if (argc < 3) {
+        printf("Usage: %s <input> <output> [budget MB] [fan-in]\n", argv[0]);
+        printf("       %s bench [data MB] [budget MB] [fan-in] [dir]\n", argv[0]);
+        return 1;
+    }
+
+    size_t budgetMB = argc > 3 ? (size_t)atol(argv[3]) : DEFAULT_BUDGET_MB;
+    int fanIn = argc > 4 ? atoi(argv[4]) : DEFAULT_FAN_IN;
+    SortReport r = externalSort(argv[1], argv[2], budgetMB * 1048576, fanIn);
+    printf("Sorted %s -> %s: %d runs, %d merge passes (fan-in %d), %.2f s\n",
+           argv[1], argv[2], r.runs, r.passes, r.fanIn, r.runSeconds + r.mergeSeconds);
+    return 0;
+}
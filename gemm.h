@@ -0,0 +1,277 @@
+#ifndef GEMM_H
+#define GEMM_H
+
+// Dense matrix multiply C = A * B (or C += A * B) for int32, float and
+// double, shared by matrix.c and yuv_bkl.c.
+//
+// The structure is the classic packed GEMM: the loop nest is blocked so
+// that a KC x NC panel of B stays in L3, an MC x KC block of A stays in L2,
+// and a KC x NR sliver of B stays in L1 while the micro-kernel streams an
+// MR-row sliver of A past it. Both operands are first packed into those
+// slivers, contiguous and zero-padded to whole tiles, so the micro-kernel
+// reads memory strictly sequentially whatever the source strides are.
+//
+// The micro-kernel keeps an MR x NR tile of C in registers for the whole
+// KC loop: 6 rows x two 8-lane vectors = 12 AVX2 accumulators, fed by two
+// vector loads of B and six broadcasts of A per step. float and double use
+// FMA; int32 uses mullo + add. Without AVX2 (and FMA for the floating
+// types) the same tiles are computed by a scalar kernel over the same
+// packed layout. Edge tiles are computed into a local tile and copied out.
+//
+// Packing buffers are thread-local and grow on demand, so repeated calls
+// (e.g. from the leaves of a Strassen recursion) allocate nothing.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#define GEMM_MR 6       // Rows of the register tile
+#define GEMM_KC 256     // Depth of a packed sliver (KC x NR of B fits in L1)
+#define GEMM_MC 120     // Rows of A packed per L2 block (multiple of MR)
+#define GEMM_NC 2048    // Columns of B packed per L3 panel
+
+#define GEMM_NR_INT32 16
+#define GEMM_NR_FLOAT 16
+#define GEMM_NR_DOUBLE 8
+
+// --- Packing Buffers ---
+
+static _Thread_local void *gemmPackA = NULL, *gemmPackB = NULL;
+static _Thread_local size_t gemmPackABytes = 0, gemmPackBBytes = 0;
+
+static inline void *gemmBuffer(void **buffer, size_t *capacity, size_t bytes) {
+    if (bytes > *capacity) {
+        free(*buffer);
+        bytes = (bytes + 63) / 64 * 64;
+        *buffer = aligned_alloc(64, bytes);
+        if (*buffer == NULL) {
+            printf("Memory allocation failed!\n");
+            exit(1);
+        }
+        *capacity = bytes;
+    }
+    return *buffer;
+}
+
+// Frees the calling thread's packing buffers (call before a worker exits)
+static inline void gemmReleaseBuffers(void) {
+    free(gemmPackA);
+    free(gemmPackB);
+    gemmPackA = gemmPackB = NULL;
+    gemmPackABytes = gemmPackBBytes = 0;
+}
+
+// --- Micro-Kernels ---
+
+// Each computes the full MR x NR tile c (+)= a * b, where 'a' holds kc
+// columns of MR packed rows and 'b' kc rows of NR packed columns.
+
+static inline void microKernelInt32(int kc, const int32_t *a, const int32_t *b, int32_t *c, int ldc, int accumulate) {
+#ifdef __AVX2__
+    __m256i c00 = _mm256_setzero_si256(), c01 = c00, c10 = c00, c11 = c00, c20 = c00, c21 = c00;
+    __m256i c30 = c00, c31 = c00, c40 = c00, c41 = c00, c50 = c00, c51 = c00;
+    for (int p = 0; p < kc; p++, a += GEMM_MR, b += GEMM_NR_INT32) {
+        __m256i b0 = _mm256_load_si256((const __m256i *)b);
+        __m256i b1 = _mm256_load_si256((const __m256i *)(b + 8));
+        __m256i x;
+        x = _mm256_set1_epi32(a[0]);
+        c00 = _mm256_add_epi32(c00, _mm256_mullo_epi32(x, b0)); c01 = _mm256_add_epi32(c01, _mm256_mullo_epi32(x, b1));
+        x = _mm256_set1_epi32(a[1]);
+        c10 = _mm256_add_epi32(c10, _mm256_mullo_epi32(x, b0)); c11 = _mm256_add_epi32(c11, _mm256_mullo_epi32(x, b1));
+        x = _mm256_set1_epi32(a[2]);
+        c20 = _mm256_add_epi32(c20, _mm256_mullo_epi32(x, b0)); c21 = _mm256_add_epi32(c21, _mm256_mullo_epi32(x, b1));
+        x = _mm256_set1_epi32(a[3]);
+        c30 = _mm256_add_epi32(c30, _mm256_mullo_epi32(x, b0)); c31 = _mm256_add_epi32(c31, _mm256_mullo_epi32(x, b1));
+        x = _mm256_set1_epi32(a[4]);
+        c40 = _mm256_add_epi32(c40, _mm256_mullo_epi32(x, b0)); c41 = _mm256_add_epi32(c41, _mm256_mullo_epi32(x, b1));
+        x = _mm256_set1_epi32(a[5]);
+        c50 = _mm256_add_epi32(c50, _mm256_mullo_epi32(x, b0)); c51 = _mm256_add_epi32(c51, _mm256_mullo_epi32(x, b1));
+    }
+    __m256i rows[GEMM_MR][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}};
+    for (int i = 0; i < GEMM_MR; i++) {
+        __m256i *out = (__m256i *)(c + (size_t)i * ldc);
+        if (accumulate) {
+            rows[i][0] = _mm256_add_epi32(rows[i][0], _mm256_loadu_si256(out));
+            rows[i][1] = _mm256_add_epi32(rows[i][1], _mm256_loadu_si256(out + 1));
+        }
+        _mm256_storeu_si256(out, rows[i][0]);
+        _mm256_storeu_si256(out + 1, rows[i][1]);
+    }
+#else
+    int32_t tile[GEMM_MR][GEMM_NR_INT32] = {{0}};
+    for (int p = 0; p < kc; p++, a += GEMM_MR, b += GEMM_NR_INT32)
+        for (int i = 0; i < GEMM_MR; i++)
+            for (int j = 0; j < GEMM_NR_INT32; j++)
+                tile[i][j] += a[i] * b[j];
+    for (int i = 0; i < GEMM_MR; i++)
+        for (int j = 0; j < GEMM_NR_INT32; j++)
+            c[(size_t)i * ldc + j] = accumulate ? c[(size_t)i * ldc + j] + tile[i][j] : tile[i][j];
+#endif
+}
+
+static inline void microKernelFloat(int kc, const float *a, const float *b, float *c, int ldc, int accumulate) {
+#if defined(__AVX2__) && defined(__FMA__)
+    __m256 c00 = _mm256_setzero_ps(), c01 = c00, c10 = c00, c11 = c00, c20 = c00, c21 = c00;
+    __m256 c30 = c00, c31 = c00, c40 = c00, c41 = c00, c50 = c00, c51 = c00;
+    for (int p = 0; p < kc; p++, a += GEMM_MR, b += GEMM_NR_FLOAT) {
+        __m256 b0 = _mm256_load_ps(b);
+        __m256 b1 = _mm256_load_ps(b + 8);
+        __m256 x;
+        x = _mm256_broadcast_ss(a + 0); c00 = _mm256_fmadd_ps(x, b0, c00); c01 = _mm256_fmadd_ps(x, b1, c01);
+        x = _mm256_broadcast_ss(a + 1); c10 = _mm256_fmadd_ps(x, b0, c10); c11 = _mm256_fmadd_ps(x, b1, c11);
+        x = _mm256_broadcast_ss(a + 2); c20 = _mm256_fmadd_ps(x, b0, c20); c21 = _mm256_fmadd_ps(x, b1, c21);
+        x = _mm256_broadcast_ss(a + 3); c30 = _mm256_fmadd_ps(x, b0, c30); c31 = _mm256_fmadd_ps(x, b1, c31);
+        x = _mm256_broadcast_ss(a + 4); c40 = _mm256_fmadd_ps(x, b0, c40); c41 = _mm256_fmadd_ps(x, b1, c41);
+        x = _mm256_broadcast_ss(a + 5); c50 = _mm256_fmadd_ps(x, b0, c50); c51 = _mm256_fmadd_ps(x, b1, c51);
+    }
+    __m256 rows[GEMM_MR][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}};
+    for (int i = 0; i < GEMM_MR; i++) {
+        float *out = c + (size_t)i * ldc;
+        if (accumulate) {
+            rows[i][0] = _mm256_add_ps(rows[i][0], _mm256_loadu_ps(out));
+            rows[i][1] = _mm256_add_ps(rows[i][1], _mm256_loadu_ps(out + 8));
+        }
+        _mm256_storeu_ps(out, rows[i][0]);
+        _mm256_storeu_ps(out + 8, rows[i][1]);
+    }
+#else
+    float tile[GEMM_MR][GEMM_NR_FLOAT] = {{0}};
+    for (int p = 0; p < kc; p++, a += GEMM_MR, b += GEMM_NR_FLOAT)
+        for (int i = 0; i < GEMM_MR; i++)
+            for (int j = 0; j < GEMM_NR_FLOAT; j++)
+                tile[i][j] += a[i] * b[j];
+    for (int i = 0; i < GEMM_MR; i++)
+        for (int j = 0; j < GEMM_NR_FLOAT; j++)
+            c[(size_t)i * ldc + j] = accumulate ? c[(size_t)i * ldc + j] + tile[i][j] : tile[i][j];
+#endif
+}
+
+static inline void microKernelDouble(int kc, const double *a, const double *b, double *c, int ldc, int accumulate) {
+#if defined(__AVX2__) && defined(__FMA__)
+    __m256d c00 = _mm256_setzero_pd(), c01 = c00, c10 = c00, c11 = c00, c20 = c00, c21 = c00;
+    __m256d c30 = c00, c31 = c00, c40 = c00, c41 = c00, c50 = c00, c51 = c00;
+    for (int p = 0; p < kc; p++, a += GEMM_MR, b += GEMM_NR_DOUBLE) {
+        __m256d b0 = _mm256_load_pd(b);
+        __m256d b1 = _mm256_load_pd(b + 4);
+        __m256d x;
+        x = _mm256_broadcast_sd(a + 0); c00 = _mm256_fmadd_pd(x, b0, c00); c01 = _mm256_fmadd_pd(x, b1, c01);
+        x = _mm256_broadcast_sd(a + 1); c10 = _mm256_fmadd_pd(x, b0, c10); c11 = _mm256_fmadd_pd(x, b1, c11);
+        x = _mm256_broadcast_sd(a + 2); c20 = _mm256_fmadd_pd(x, b0, c20); c21 = _mm256_fmadd_pd(x, b1, c21);
+        x = _mm256_broadcast_sd(a + 3); c30 = _mm256_fmadd_pd(x, b0, c30); c31 = _mm256_fmadd_pd(x, b1, c31);
+        x = _mm256_broadcast_sd(a + 4); c40 = _mm256_fmadd_pd(x, b0, c40); c41 = _mm256_fmadd_pd(x, b1, c41);
+        x = _mm256_broadcast_sd(a + 5); c50 = _mm256_fmadd_pd(x, b0, c50); c51 = _mm256_fmadd_pd(x, b1, c51);
+    }
+    __m256d rows[GEMM_MR][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}};
+    for (int i = 0; i < GEMM_MR; i++) {
+        double *out = c + (size_t)i * ldc;
+        if (accumulate) {
+            rows[i][0] = _mm256_add_pd(rows[i][0], _mm256_loadu_pd(out));
+            rows[i][1] = _mm256_add_pd(rows[i][1], _mm256_loadu_pd(out + 4));
+        }
+        _mm256_storeu_pd(out, rows[i][0]);
+        _mm256_storeu_pd(out + 4, rows[i][1]);
+    }
+#else
+    double tile[GEMM_MR][GEMM_NR_DOUBLE] = {{0}};
+    for (int p = 0; p < kc; p++, a += GEMM_MR, b += GEMM_NR_DOUBLE)
+        for (int i = 0; i < GEMM_MR; i++)
+            for (int j = 0; j < GEMM_NR_DOUBLE; j++)
+                tile[i][j] += a[i] * b[j];
+    for (int i = 0; i < GEMM_MR; i++)
+        for (int j = 0; j < GEMM_NR_DOUBLE; j++)
+            c[(size_t)i * ldc + j] = accumulate ? c[(size_t)i * ldc + j] + tile[i][j] : tile[i][j];
+#endif
+}
+
+// --- Packing and Driver ---
+
+// Generates, for element type T with register tile MR x NR:
+//   packA<Suffix>:  mc x kc block of A -> MR-row slivers, column by column
+//   packB<Suffix>:  kc x nc panel of B -> NR-column slivers, row by row
+//   gemm<Suffix>:   the blocked loop nest around microKernel<Suffix>
+// Slivers are zero-padded to a full MR or NR, so the kernel never branches
+// on edges; only the write-back of an edge tile goes through 'tile'.
+#define GEMM_DEFINE(Suffix, T, NR)                                                              \
+static inline void packA##Suffix(int mc, int kc, const T *A, int lda, T *out) {                 \
+    for (int i = 0; i < mc; i += GEMM_MR) {                                                     \
+        int rows = mc - i < GEMM_MR ? mc - i : GEMM_MR;                                         \
+        for (int p = 0; p < kc; p++) {                                                          \
+            for (int r = 0; r < rows; r++) *out++ = A[(size_t)(i + r) * lda + p];               \
+            for (int r = rows; r < GEMM_MR; r++) *out++ = 0;                                    \
+        }                                                                                       \
+    }                                                                                           \
+}                                                                                               \
+                                                                                                \
+static inline void packB##Suffix(int kc, int nc, const T *B, int ldb, T *out) {                 \
+    for (int j = 0; j < nc; j += NR) {                                                          \
+        int cols = nc - j < NR ? nc - j : NR;                                                   \
+        for (int p = 0; p < kc; p++) {                                                          \
+            const T *row = B + (size_t)p * ldb + j;                                             \
+            if (cols == NR) {                                                                   \
+                memcpy(out, row, NR * sizeof(T));                                               \
+            } else {                                                                            \
+                memcpy(out, row, (size_t)cols * sizeof(T));                                     \
+                memset(out + cols, 0, (size_t)(NR - cols) * sizeof(T));                         \
+            }                                                                                   \
+            out += NR;                                                                          \
+        }                                                                                       \
+    }                                                                                           \
+}                                                                                               \
+                                                                                                \
+/* C (+)= A * B for row-major A (m x k), B (k x n), C (m x n) with leading  */                  \
+/* dimensions lda, ldb, ldc. With accumulate == 0, C is overwritten.        */                  \
+static inline void gemm##Suffix(int m, int n, int k, const T *A, int lda, const T *B, int ldb,  \
+                                T *C, int ldc, int accumulate) {                                \
+    if (k == 0) {                                                                               \
+        if (!accumulate)                                                                        \
+            for (int i = 0; i < m; i++) memset(C + (size_t)i * ldc, 0, (size_t)n * sizeof(T));  \
+        return;                                                                                 \
+    }                                                                                           \
+    T *packedA = (T *)gemmBuffer(&gemmPackA, &gemmPackABytes,                                   \
+                                 (size_t)GEMM_MC * GEMM_KC * sizeof(T));                        \
+    T *packedB = (T *)gemmBuffer(&gemmPackB, &gemmPackBBytes,                                   \
+                                 (size_t)GEMM_KC * (GEMM_NC + NR) * sizeof(T));                 \
+    _Alignas(32) T tile[GEMM_MR * NR];                                                          \
+    for (int jc = 0; jc < n; jc += GEMM_NC) {                                                   \
+        int nc = n - jc < GEMM_NC ? n - jc : GEMM_NC;                                           \
+        for (int pc = 0; pc < k; pc += GEMM_KC) {                                               \
+            int kc = k - pc < GEMM_KC ? k - pc : GEMM_KC;                                       \
+            int acc = accumulate || pc > 0;                                                     \
+            packB##Suffix(kc, nc, B + (size_t)pc * ldb + jc, ldb, packedB);                     \
+            for (int ic = 0; ic < m; ic += GEMM_MC) {                                           \
+                int mc = m - ic < GEMM_MC ? m - ic : GEMM_MC;                                   \
+                packA##Suffix(mc, kc, A + (size_t)ic * lda + pc, lda, packedA);                 \
+                for (int jr = 0; jr < nc; jr += NR) {                                           \
+                    int cols = nc - jr < NR ? nc - jr : NR;                                     \
+                    const T *b = packedB + (size_t)jr * kc;                                     \
+                    for (int ir = 0; ir < mc; ir += GEMM_MR) {                                  \
+                        int rows = mc - ir < GEMM_MR ? mc - ir : GEMM_MR;                       \
+                        const T *a = packedA + (size_t)ir * kc;                                 \
+                        T *c = C + (size_t)(ic + ir) * ldc + jc + jr;                           \
+                        if (rows == GEMM_MR && cols == NR) {                                    \
+                            microKernel##Suffix(kc, a, b, c, ldc, acc);                         \
+                            continue;                                                           \
+                        }                                                                       \
+                        microKernel##Suffix(kc, a, b, tile, NR, 0);                             \
+                        for (int i = 0; i < rows; i++)                                          \
+                            for (int j = 0; j < cols; j++)                                      \
+                                c[(size_t)i * ldc + j] = acc ? c[(size_t)i * ldc + j]           \
+                                    + tile[i * NR + j] : tile[i * NR + j];                      \
+                    }                                                                           \
+                }                                                                               \
+            }                                                                                   \
+        }                                                                                       \
+    }                                                                                           \
+}
+
+GEMM_DEFINE(Int32, int32_t, GEMM_NR_INT32)
+GEMM_DEFINE(Float, float, GEMM_NR_FLOAT)
+GEMM_DEFINE(Double, double, GEMM_NR_DOUBLE)
+
+#endif // GEMM_H
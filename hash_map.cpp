@@ -0,0 +1,353 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <new>
+#include <utility>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+// User information: Always use namespace std.
+using namespace std;
+
+// --- Hashing Helpers ---
+
+// Finalizer applied to every user hash. std::hash<int> is the identity, which
+// would put consecutive keys in consecutive slots of a power-of-two table.
+inline size_t mixHash(size_t h) {
+    uint64_t x = h;
+    x ^= x >> 33; x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33; x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return (size_t)x;
+}
+
+// Transparent string hash: std::string, string_view and const char* all hash
+// through string_view, so lookups never have to build a temporary std::string.
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(string_view s) const { return hash<string_view>{}(s); }
+};
+
+/**
+ * @brief Open-addressing hash map with linear probing and cached hashes.
+ *
+ * Every slot stores the full (mixed) hash of its key in a separate, dense
+ * array. A probe scans that array and compares keys only when the hashes
+ * match, so almost every mismatch is rejected without touching the entry
+ * (for string keys, without a string compare). A cached hash of 0 marks an
+ * empty slot; real hashes are forced non-zero. Deletion uses backward
+ * shifting, so there are no tombstones and any key value is legal.
+ *
+ * If both Hash and KeyEqual declare is_transparent, find/contains/erase accept
+ * any type they can hash and compare (e.g. string_view for string keys).
+ */
+template <typename K, typename V, typename Hash = hash<K>, typename KeyEqual = equal_to<K>>
+class HashMap {
+public:
+    using Entry = pair<K, V>;
+
+    explicit HashMap(size_t initialCapacity = 16) { allocate(roundUp(initialCapacity)); }
+
+    ~HashMap() {
+        destroyAll();
+        ::operator delete(entries, align_val_t(alignof(Entry)));
+    }
+
+    HashMap(const HashMap&) = delete;
+    HashMap& operator=(const HashMap&) = delete;
+
+    size_t size() const { return count; }
+    size_t capacity() const { return mask + 1; }
+    bool empty() const { return count == 0; }
+
+    // Inserts (key, value) if key is absent. Returns the stored value and
+    // whether an insertion happened.
+    template <typename KArg, typename... VArgs>
+    pair<V*, bool> emplace(KArg&& key, VArgs&&... args) {
+        size_t h = hashOf(key);
+        size_t i = h & mask;
+        while (hashes[i] != 0) {
+            if (hashes[i] == h && equal(entries[i].first, key)) return {&entries[i].second, false};
+            i = (i + 1) & mask;
+        }
+        if ((count + 1) * 8 > capacity() * 7) { // Keep load factor at or below 7/8
+            grow();
+            i = h & mask;
+            while (hashes[i] != 0) i = (i + 1) & mask;
+        }
+        new (&entries[i]) Entry(piecewise_construct,
+                                forward_as_tuple(std::forward<KArg>(key)),
+                                forward_as_tuple(std::forward<VArgs>(args)...));
+        hashes[i] = h;
+        count++;
+        return {&entries[i].second, true};
+    }
+
+    bool insert(const K& key, const V& value) { return emplace(key, value).second; }
+
+    V& operator[](const K& key) { return *emplace(key).first; }
+
+    // Returns a pointer to the value for key, or nullptr if absent
+    template <typename Q, typename H = Hash, typename E = KeyEqual,
+              typename = typename H::is_transparent, typename = typename E::is_transparent>
+    V* find(const Q& key) { return findImpl(key); }
+    V* find(const K& key) { return findImpl(key); }
+
+    template <typename Q, typename H = Hash, typename E = KeyEqual,
+              typename = typename H::is_transparent, typename = typename E::is_transparent>
+    bool contains(const Q& key) const { return indexOf(key) != NOT_FOUND; }
+    bool contains(const K& key) const { return indexOf(key) != NOT_FOUND; }
+
+    template <typename Q, typename H = Hash, typename E = KeyEqual,
+              typename = typename H::is_transparent, typename = typename E::is_transparent>
+    bool erase(const Q& key) { return eraseImpl(key); }
+    bool erase(const K& key) { return eraseImpl(key); }
+
+    // Calls fn(key, value) for every entry, in slot order
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (size_t i = 0; i <= mask; i++)
+            if (hashes[i] != 0) fn(entries[i].first, entries[i].second);
+    }
+
+private:
+    static constexpr size_t NOT_FOUND = (size_t)-1;
+
+    vector<size_t> hashes;  // 0 = empty slot
+    Entry* entries = nullptr;
+    size_t mask = 0;
+    size_t count = 0;
+    Hash hasher;
+    KeyEqual equal;
+
+    static size_t roundUp(size_t n) {
+        size_t c = 8;
+        while (c < n) c <<= 1;
+        return c;
+    }
+
+    template <typename Q>
+    size_t hashOf(const Q& key) const {
+        size_t h = mixHash(hasher(key));
+        return h ? h : 1;
+    }
+
+    void allocate(size_t cap) {
+        hashes.assign(cap, 0);
+        entries = static_cast<Entry*>(::operator new(cap * sizeof(Entry), align_val_t(alignof(Entry))));
+        mask = cap - 1;
+        count = 0;
+    }
+
+    void destroyAll() {
+        for (size_t i = 0; i <= mask; i++)
+            if (hashes[i] != 0) entries[i].~Entry();
+    }
+
+    void grow() {
+        vector<size_t> oldHashes;
+        oldHashes.swap(hashes);
+        Entry* oldEntries = entries;
+        size_t oldCap = mask + 1;
+
+        allocate(oldCap * 2);
+        for (size_t j = 0; j < oldCap; j++) {
+            if (oldHashes[j] == 0) continue;
+            // Cached hashes make rehashing free of hash recomputation
+            size_t i = oldHashes[j] & mask;
+            while (hashes[i] != 0) i = (i + 1) & mask;
+            new (&entries[i]) Entry(std::move(oldEntries[j]));
+            hashes[i] = oldHashes[j];
+            oldEntries[j].~Entry();
+            count++;
+        }
+        ::operator delete(oldEntries, align_val_t(alignof(Entry)));
+    }
+
+    template <typename Q>
+    size_t indexOf(const Q& key) const {
+        size_t h = hashOf(key);
+        for (size_t i = h & mask; hashes[i] != 0; i = (i + 1) & mask)
+            if (hashes[i] == h && equal(entries[i].first, key)) return i;
+        return NOT_FOUND;
+    }
+
+    template <typename Q>
+    V* findImpl(const Q& key) {
+        size_t i = indexOf(key);
+        return i == NOT_FOUND ? nullptr : &entries[i].second;
+    }
+
+    // Backward-shift deletion: pull later members of the cluster into the hole
+    // whenever their home slot is at or before it.
+    template <typename Q>
+    bool eraseImpl(const Q& key) {
+        size_t hole = indexOf(key);
+        if (hole == NOT_FOUND) return false;
+        entries[hole].~Entry();
+        hashes[hole] = 0;
+        count--;
+
+        for (size_t i = (hole + 1) & mask; hashes[i] != 0; i = (i + 1) & mask) {
+            size_t home = hashes[i] & mask;
+            if (((i - home) & mask) >= ((i - hole) & mask)) {
+                new (&entries[hole]) Entry(std::move(entries[i]));
+                hashes[hole] = hashes[i];
+                entries[i].~Entry();
+                hashes[i] = 0;
+                hole = i;
+            }
+        }
+        return true;
+    }
+};
+
+// Convenience alias: string keys with heterogeneous string_view lookup
+template <typename V>
+using StringMap = HashMap<string, V, StringHash, equal_to<>>;
+
+// --- Benchmark ---
+
+using Clock = chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+static volatile long long sink; // Keeps lookup loops from being optimized away
+
+static void printHeader(const string& title) {
+    cout << "\n" << left << setw(28) << title << right << setw(16) << "HashMap"
+         << setw(19) << "unordered_map" << setw(10) << "speedup" << endl;
+}
+
+static void printRow(const string& name, double ours, double theirs, size_t ops) {
+    cout << "  " << left << setw(26) << name << right << fixed << setprecision(1)
+         << setw(9) << ops / ours / 1e6 << " Mops/s"
+         << setw(12) << ops / theirs / 1e6 << " Mops/s"
+         << setw(9) << setprecision(2) << theirs / ours << "x" << endl;
+}
+
+void benchmarkIntKeys(size_t n) {
+    mt19937_64 rng(42);
+    vector<int> keys(n), misses(n);
+    for (auto& k : keys) k = (int)rng();
+    for (auto& k : misses) k = (int)rng();
+
+    HashMap<int, int> ours;
+    unordered_map<int, int> theirs;
+
+    auto t = Clock::now();
+    for (size_t i = 0; i < n; i++) ours.insert(keys[i], (int)i);
+    double oursInsert = secondsSince(t);
+    t = Clock::now();
+    for (size_t i = 0; i < n; i++) theirs.emplace(keys[i], (int)i);
+    double theirsInsert = secondsSince(t);
+
+    t = Clock::now();
+    for (size_t i = 0; i < n; i++) sink += ours.find(keys[i]) != nullptr;
+    double oursHit = secondsSince(t);
+    t = Clock::now();
+    for (size_t i = 0; i < n; i++) sink += theirs.find(keys[i]) != theirs.end();
+    double theirsHit = secondsSince(t);
+
+    t = Clock::now();
+    for (size_t i = 0; i < n; i++) sink += ours.find(misses[i]) != nullptr;
+    double oursMiss = secondsSince(t);
+    t = Clock::now();
+    for (size_t i = 0; i < n; i++) sink += theirs.find(misses[i]) != theirs.end();
+    double theirsMiss = secondsSince(t);
+
+    printHeader("int -> int, " + to_string(n) + " keys");
+    printRow("insert", oursInsert, theirsInsert, n);
+    printRow("lookup (hit)", oursHit, theirsHit, n);
+    printRow("lookup (miss)", oursMiss, theirsMiss, n);
+}
+
+void benchmarkStringKeys(size_t n) {
+    mt19937_64 rng(7);
+    // Long common prefix: mismatches are expensive unless the hash rejects them
+    auto makeKey = [&](uint64_t v) { return "customer/account/region-eu-west/" + to_string(v); };
+    vector<string> keys(n), misses(n);
+    for (auto& k : keys) k = makeKey(rng());
+    for (auto& k : misses) k = makeKey(rng());
+
+    StringMap<int> ours;
+    unordered_map<string, int> theirs;
+
+    auto t = Clock::now();
+    for (size_t i = 0; i < n; i++) ours.insert(keys[i], (int)i);
+    double oursInsert = secondsSince(t);
+    t = Clock::now();
+    for (size_t i = 0; i < n; i++) theirs.emplace(keys[i], (int)i);
+    double theirsInsert = secondsSince(t);
+
+    // Callers hold string_views (e.g. slices of a request buffer). HashMap
+    // looks them up directly; unordered_map must materialize a std::string.
+    vector<string_view> hitViews(keys.begin(), keys.end()), missViews(misses.begin(), misses.end());
+    t = Clock::now();
+    for (size_t i = 0; i < n; i++) sink += ours.find(hitViews[i]) != nullptr;
+    double oursHit = secondsSince(t);
+    t = Clock::now();
+    for (size_t i = 0; i < n; i++) sink += theirs.find(string(hitViews[i])) != theirs.end();
+    double theirsHit = secondsSince(t);
+
+    t = Clock::now();
+    for (size_t i = 0; i < n; i++) sink += ours.find(missViews[i]) != nullptr;
+    double oursMiss = secondsSince(t);
+    t = Clock::now();
+    for (size_t i = 0; i < n; i++) sink += theirs.find(string(missViews[i])) != theirs.end();
+    double theirsMiss = secondsSince(t);
+
+    printHeader("string -> int, " + to_string(n) + " keys");
+    printRow("insert", oursInsert, theirsInsert, n);
+    printRow("string_view lookup (hit)", oursHit, theirsHit, n);
+    printRow("string_view lookup (miss)", oursMiss, theirsMiss, n);
+}
+
+// --- Driver Code ---
+// Usage: ./hash_map               (demo)
+//        ./hash_map bench [n]
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "bench") {
+        size_t n = argc > 2 ? stoul(argv[2]) : 1000000;
+        cout << "--- HashMap vs std::unordered_map ---" << endl;
+        benchmarkIntKeys(n);
+        benchmarkStringKeys(n);
+        return 0;
+    }
+
+    // Keys that the C tables in hashing.c / hashing_open.c cannot store:
+    // -1 and 0 are ordinary keys here, and each key carries a payload.
+    HashMap<int, string> ids;
+    ids.insert(-1, "minus one");
+    ids.insert(0, "zero");
+    ids.insert(44, "forty-four");
+    ids[36] = "thirty-six";
+
+    cout << "--- HashMap<int, string> ---" << endl;
+    ids.forEach([](int k, const string& v) { cout << "  " << setw(3) << k << " -> " << v << endl; });
+    cout << "  find(0): " << (ids.find(0) ? *ids.find(0) : "NOT FOUND") << endl;
+    ids.erase(0);
+    cout << "  after erase(0), contains(0): " << (ids.contains(0) ? "yes" : "no") << endl;
+
+    StringMap<int> stock;
+    stock.insert("apples", 12);
+    stock.insert("pears", 7);
+    stock["plums"] += 3;
+
+    string_view query = "pears-and-more";
+    query = query.substr(0, 5); // "pears", found without building a std::string
+    cout << "\n--- StringMap<int> ---" << endl;
+    cout << "  stock[\"" << query << "\"] = " << *stock.find(query) << endl;
+    cout << "  contains(\"kiwis\"): " << (stock.contains(string_view("kiwis")) ? "yes" : "no") << endl;
+    cout << "  size: " << stock.size() << ", capacity: " << stock.capacity() << endl;
+
+    return 0;
+}
@@ -1,13 +1,87 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
 #include <math.h> // For pow() function
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "bloom.h"
 
 // --- Configuration ---
-#define TABLE_SIZE 10
+#define TABLE_SIZE 10       // Size used by the demo in main()
 #define EMPTY_SLOT -1
+#define PREFETCH_GROUP 16   // Keys hashed and prefetched together by lookup_batch()
 
-// Global hash table (array of integers)
-int hashTable[TABLE_SIZE];
+// Status codes returned by insert()
+#define INSERT_OK 0
+#define INSERT_DUPLICATE 1
+#define INSERT_FULL -1
+#define INSERT_READ_ONLY -2 // Table is a mapped snapshot
+
+// --- Snapshot File Format ---
+// [SnapshotHeader, zero-padded to SNAPSHOT_ALIGN][int slots[tableSize]]
+// The slot array starts on a page boundary, so a read-only mmap of the file
+// can be used directly as hashTable without copying or deserializing.
+#define SNAPSHOT_MAGIC "HASHSNAP"
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_ALIGN 4096
+#define HASH_MID_SQUARE 1   // Identifies the hash function the slots were placed with
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t hashFunction;
+    int32_t emptySlot;
+    int32_t tableSize;
+    int32_t keyCount;
+    uint32_t reserved;
+    uint64_t dataOffset;    // Byte offset of the slot array (multiple of SNAPSHOT_ALIGN)
+    uint64_t dataBytes;
+} SnapshotHeader;
+
+// Global hash table (array of integers), sized at runtime by initTable()
+int *hashTable = NULL;
+int tableSize = 0;
+int keyCount = 0;
+
+// Set while hashTable points into a read-only snapshot mapping
+void *snapshotMapping = NULL;
+size_t snapshotBytes = 0;
+
+// Optional Bloom filter in front of search() and lookup_batch(), so absent
+// keys usually skip the mid-square hash and the probe sequence entirely
+BloomFilter keyFilter;
+int filterEnabled = 0;
+double filterFpr = 0.01;
+
+// --- Optional Telemetry (compile with -DHASH_STATS) ---
+// Without HASH_STATS every STAT(...) expands to nothing, so the insert and
+// lookup paths are exactly the uninstrumented code.
+#ifdef HASH_STATS
+#define STAT(x) x
+#define HIST_BUCKETS 33 // Probe lengths 0..31; the last bucket counts 32 and longer
+
+typedef struct {
+    unsigned long long insertProbes[HIST_BUCKETS]; // Slots skipped past the home slot
+    unsigned long long lookupProbes[HIST_BUCKETS];
+    unsigned long long inserts, duplicates, failedInserts;
+    unsigned long long hits, misses;
+    unsigned long long filterRejects; // Lookups answered "absent" by the Bloom filter
+} HashStats;
+
+HashStats stats;
+
+static void recordProbe(unsigned long long *hist, int length) {
+    hist[length < HIST_BUCKETS - 1 ? length : HIST_BUCKETS - 1]++;
+}
+#else
+#define STAT(x)
+#endif
 
 // --- Utility Functions for Mid-Square ---
 
@@ -29,8 +103,8 @@ int get_digits_range(long long num, int start_pos, int count) {
     
     // Ensure the range is valid (Simplified: takes the middle digits)
     if (start_pos < 1 || start_pos + count - 1 > length) {
-        // Fallback for simple systems: Use the last digit modulo TABLE_SIZE
-        if (TABLE_SIZE > 0) return num % TABLE_SIZE;
+        // Fallback for simple systems: Use the last digit modulo tableSize
+        if (tableSize > 0) return num % tableSize;
         return 0;
     }
 
@@ -54,57 +128,359 @@ int midSquareHash(int key) {
     // 2. Extract the middle digits.
     int keysquare_len = count_digits(squaredKey);
     
-    // Number of digits to extract for the hash index (log10(TABLE_SIZE))
-    int hash_digits_count = 1; // Simplification: we'll extract 1 digit.
+    // Number of digits to extract for the hash index (log10(tableSize)),
+    // e.g. 1 digit for the 10-slot demo table.
+    int hash_digits_count = count_digits(tableSize - 1);
     
     // Calculate the start position for the middle digit(s).
     // The middle digit's position (1-indexed from left) is floor(length/2) + 1
     int mid_pos = keysquare_len / 2;
-    int start_pos = mid_pos + 1; 
+    int start_pos = mid_pos + 1 - (hash_digits_count - 1) / 2;
 
     int hash_index = get_digits_range(squaredKey, start_pos, hash_digits_count);
 
-    // 3. Take modulo TABLE_SIZE to get the final index
-    return hash_index % TABLE_SIZE;
+    // 3. Take modulo tableSize to get the final index
+    return hash_index % tableSize;
+}
+
+// --- Table Setup ---
+void rebuildFilter();
+
+// Frees the table, or unmaps it if it came from loadSnapshot()
+void releaseTable() {
+    if (snapshotMapping != NULL) {
+        munmap(snapshotMapping, snapshotBytes);
+        snapshotMapping = NULL;
+        snapshotBytes = 0;
+    } else {
+        free(hashTable);
+    }
+    hashTable = NULL;
+    tableSize = 0;
+    keyCount = 0;
+}
+
+// Allocates a table of 'size' slots, all EMPTY_SLOT
+void initTable(int size) {
+    releaseTable();
+    hashTable = (int *)malloc((size_t)size * sizeof(int));
+    if (hashTable == NULL) {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
+    tableSize = size;
+    keyCount = 0;
+    for (int i = 0; i < tableSize; ++i) {
+        hashTable[i] = EMPTY_SLOT;
+    }
+    rebuildFilter();
+}
+
+// --- Bloom Filter Layer ---
+
+// Re-derives the filter from the table. Sized for a full table, so inserts
+// never outgrow it; only bulk paths that bypass insert() need to call this.
+void rebuildFilter() {
+    if (!filterEnabled) return;
+    if (keyFilter.blocks == NULL || keyFilter.capacity < (uint32_t)tableSize) {
+        bloomFree(&keyFilter);
+        bloomInit(&keyFilter, (uint32_t)tableSize, filterFpr);
+    } else {
+        bloomClear(&keyFilter);
+    }
+    for (int i = 0; i < tableSize; ++i) {
+        if (hashTable[i] != EMPTY_SLOT) bloomAdd(&keyFilter, hashTable[i]);
+    }
+}
+
+void enableFilter(double fpr) {
+    bloomFree(&keyFilter);
+    filterEnabled = 1;
+    filterFpr = fpr;
+    rebuildFilter();
+}
+
+void disableFilter() {
+    filterEnabled = 0;
+    bloomFree(&keyFilter);
 }
 
 // --- Closed Hashing (Linear Probing) Insertion ---
-void insert(int key) {
+// Returns INSERT_OK, INSERT_DUPLICATE, INSERT_FULL or INSERT_READ_ONLY. Does no I/O.
+// When 'slot' is not NULL it receives the index the key was stored at or
+// found at (so callers can report it without a counted lookup).
+int insertAt(int key, int *slot) {
+    if (snapshotMapping != NULL) return INSERT_READ_ONLY;
+
     int index = midSquareHash(key);
     int original_index = index;
     int i = 0;
 
-    // Linear Probing: Probe sequentially (index + i) % TABLE_SIZE
+    // Linear Probing: Probe sequentially (index + i) % tableSize
     do {
         if (hashTable[index] == EMPTY_SLOT) {
             // Found an empty slot
             hashTable[index] = key;
-            printf("Inserted %d at index %d\n", key, index);
-            return;
+            keyCount++;
+            if (filterEnabled) bloomAdd(&keyFilter, key);
+            if (slot != NULL) *slot = index;
+            STAT(stats.inserts++; recordProbe(stats.insertProbes, i));
+            return INSERT_OK;
         }
         
         // This check prevents infinite loop if the key is already present 
         // and we want to prevent duplicates.
         if (hashTable[index] == key) {
-            printf("Key %d already exists at index %d (No insert)\n", key, index);
-            return;
+            if (slot != NULL) *slot = index;
+            STAT(stats.duplicates++; recordProbe(stats.insertProbes, i));
+            return INSERT_DUPLICATE;
         }
 
         // Move to the next slot (linear probe)
         i++;
-        index = (original_index + i) % TABLE_SIZE;
+        index = (original_index + i) % tableSize;
 
     } while (index != original_index); // Stop if we've looped through the whole table
 
     // If the loop finishes without insertion, the table is full
-    printf("Hash Table is full! Cannot insert %d\n", key);
+    STAT(stats.failedInserts++);
+    return INSERT_FULL;
+}
+
+int insert(int key) {
+    return insertAt(key, NULL);
+}
+
+// --- Search ---
+// Continues the linear probe from 'index'; returns the slot holding key or -1
+static int probeFrom(int index, int key) {
+    int original_index = index;
+    STAT(int probes = 0);
+    do {
+        if (hashTable[index] == key) {
+            STAT(stats.hits++; recordProbe(stats.lookupProbes, probes));
+            return index;
+        }
+        if (hashTable[index] == EMPTY_SLOT) break;
+        index = (index + 1) % tableSize;
+        STAT(probes++);
+    } while (index != original_index);
+    STAT(stats.misses++; recordProbe(stats.lookupProbes, probes));
+    return -1;
 }
 
+int search(int key) {
+    if (filterEnabled && !bloomMayContain(&keyFilter, key)) {
+        STAT(stats.misses++; stats.filterRejects++);
+        return -1;
+    }
+    return probeFrom(midSquareHash(key), key);
+}
+
+// --- Batched Search with Software Prefetching ---
+/**
+ * Looks up keys[0..n-1], writing each key's slot index (or -1) to out[i].
+ * Keys are processed in groups of PREFETCH_GROUP: the whole group is hashed
+ * and its home slots prefetched first, then the probes run while the other
+ * misses are still in flight. Returns the number of keys found.
+ */
+int lookup_batch(const int *keys, int n, int *out) {
+    int home[PREFETCH_GROUP];
+    int found = 0;
+
+    for (int base = 0; base < n; base += PREFETCH_GROUP) {
+        int g = n - base < PREFETCH_GROUP ? n - base : PREFETCH_GROUP;
+
+        // Stage 1: hash the group and issue a prefetch for every home slot
+        // (keys the Bloom filter rules out are marked -1 and never probed)
+        for (int j = 0; j < g; j++) {
+            if (filterEnabled && !bloomMayContain(&keyFilter, keys[base + j])) {
+                home[j] = -1;
+                STAT(stats.misses++; stats.filterRejects++);
+                continue;
+            }
+            home[j] = midSquareHash(keys[base + j]);
+            __builtin_prefetch(&hashTable[home[j]], 0, 0);
+        }
+
+        // Stage 2: resolve the probes; home slots are (mostly) in cache now
+        for (int j = 0; j < g; j++) {
+            out[base + j] = home[j] < 0 ? -1 : probeFrom(home[j], keys[base + j]);
+            found += out[base + j] >= 0;
+        }
+    }
+    return found;
+}
+
+
+// --- Parallel Build ---
+// Linear probing without deletes stays valid under concurrent inserts as long
+// as each slot is claimed with a compare-and-swap: a claimed slot never goes
+// back to EMPTY_SLOT, so every probe sequence still ends at the key or a gap.
+
+typedef struct {
+    const int *keys;
+    int begin, end;
+    int inserted;
+} BuildTask;
+
+static void *buildWorker(void *arg) {
+    BuildTask *task = (BuildTask *)arg;
+    for (int k = task->begin; k < task->end; k++) {
+        int key = task->keys[k];
+        int index = midSquareHash(key);
+        int original_index = index;
+        do {
+            int expected = EMPTY_SLOT;
+            if (__atomic_compare_exchange_n(&hashTable[index], &expected, key, 0,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                task->inserted++;
+                break;
+            }
+            if (expected == key) break; // Duplicate, possibly from another thread
+            index = (index + 1) % tableSize;
+        } while (index != original_index);
+    }
+    return NULL;
+}
+
+// Inserts keys[0..n-1] into the current table using 'threads' threads.
+// Returns the number of keys newly inserted.
+int buildParallel(const int *keys, int n, int threads) {
+    if (snapshotMapping != NULL) return 0;
+    if (threads < 1) threads = 1;
+
+    pthread_t *ids = (pthread_t *)malloc(threads * sizeof(pthread_t));
+    BuildTask *tasks = (BuildTask *)malloc(threads * sizeof(BuildTask));
+    for (int t = 0; t < threads; t++) {
+        tasks[t].keys = keys;
+        tasks[t].begin = (int)((long long)n * t / threads);
+        tasks[t].end = (int)((long long)n * (t + 1) / threads);
+        tasks[t].inserted = 0;
+        pthread_create(&ids[t], NULL, buildWorker, &tasks[t]);
+    }
+
+    int inserted = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(ids[t], NULL);
+        inserted += tasks[t].inserted;
+    }
+    keyCount += inserted;
+    free(tasks);
+    free(ids);
+    rebuildFilter(); // Workers bypass insert(), so the filter is refilled once here
+    return inserted;
+}
+
+// --- Snapshot Save / Load ---
+
+// Writes the current table to 'path'. Returns 0 on success, -1 on error.
+int saveSnapshot(const char *path) {
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.hashFunction = HASH_MID_SQUARE;
+    header.emptySlot = EMPTY_SLOT;
+    header.tableSize = tableSize;
+    header.keyCount = keyCount;
+    header.dataOffset = SNAPSHOT_ALIGN;
+    header.dataBytes = (uint64_t)tableSize * sizeof(int);
+
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL) return -1;
+
+    static const char padding[SNAPSHOT_ALIGN];
+    int ok = fwrite(&header, sizeof(header), 1, fp) == 1
+          && fwrite(padding, SNAPSHOT_ALIGN - sizeof(header), 1, fp) == 1
+          && fwrite(hashTable, sizeof(int), tableSize, fp) == (size_t)tableSize;
+    if (fclose(fp) != 0) ok = 0;
+    return ok ? 0 : -1;
+}
+
+/**
+ * Maps a snapshot read-only and makes it the current table. Only the header
+ * is validated, so the cost does not depend on the table size; slot pages
+ * are faulted in by the first lookups that touch them. Returns 0 on success,
+ * -1 if the file is missing, truncated, from an incompatible version,
+ * describes an empty table or more keys than slots, or places the slots
+ * over the header or outside the file.
+ */
+int loadSnapshot(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < SNAPSHOT_ALIGN) {
+        close(fd);
+        return -1;
+    }
+
+    void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping keeps the file referenced
+    if (base == MAP_FAILED) return -1;
+
+    const SnapshotHeader *header = (const SnapshotHeader *)base;
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0
+            || header->version != SNAPSHOT_VERSION
+            || header->hashFunction != HASH_MID_SQUARE
+            || header->emptySlot != EMPTY_SLOT
+            || header->tableSize <= 0
+            || header->keyCount < 0 || header->keyCount > header->tableSize
+            || header->dataOffset < SNAPSHOT_ALIGN || header->dataOffset % SNAPSHOT_ALIGN != 0
+            || header->dataBytes != (uint64_t)header->tableSize * sizeof(int)
+            || header->dataOffset > (uint64_t)st.st_size
+            || header->dataBytes > (uint64_t)st.st_size - header->dataOffset) {
+        munmap(base, (size_t)st.st_size);
+        return -1;
+    }
+
+    releaseTable();
+    snapshotMapping = base;
+    snapshotBytes = (size_t)st.st_size;
+    hashTable = (int *)((char *)base + header->dataOffset);
+    tableSize = header->tableSize;
+    keyCount = header->keyCount;
+    rebuildFilter(); // O(n), and only when the filter is enabled
+    return 0;
+}
+
+#ifdef HASH_STATS
+// --- Telemetry Export ---
+
+static void printHistogram(FILE *fp, const char *name, const unsigned long long *hist) {
+    int last = HIST_BUCKETS - 1;
+    while (last > 0 && hist[last] == 0) last--; // Trim trailing empty buckets
+    fprintf(fp, "  \"%s\": [", name);
+    for (int i = 0; i <= last; ++i)
+        fprintf(fp, "%s%llu", i ? ", " : "", hist[i]);
+    fprintf(fp, "]");
+}
+
+// Writes the collected statistics as a single JSON object
+void printStatsJson(FILE *fp) {
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"table\": \"linear_probing\",\n");
+    fprintf(fp, "  \"size\": %d,\n", tableSize);
+    fprintf(fp, "  \"keys\": %d,\n", keyCount);
+    fprintf(fp, "  \"load_factor\": %.4f,\n", tableSize ? (double)keyCount / tableSize : 0.0);
+    fprintf(fp, "  \"inserts\": %llu,\n", stats.inserts);
+    fprintf(fp, "  \"duplicates\": %llu,\n", stats.duplicates);
+    fprintf(fp, "  \"failed_inserts\": %llu,\n", stats.failedInserts);
+    fprintf(fp, "  \"hits\": %llu,\n", stats.hits);
+    fprintf(fp, "  \"misses\": %llu,\n", stats.misses);
+    fprintf(fp, "  \"filter_rejects\": %llu,\n", stats.filterRejects);
+    printHistogram(fp, "insert_probe_histogram", stats.insertProbes);
+    fprintf(fp, ",\n");
+    printHistogram(fp, "lookup_probe_histogram", stats.lookupProbes);
+    fprintf(fp, "\n}\n");
+}
+#endif
 
 // --- Display Function ---
 void displayTable() {
-    printf("\n--- Hash Table Contents (Size %d) ---\n", TABLE_SIZE);
-    for (int i = 0; i < TABLE_SIZE; ++i) {
+    printf("\n--- Hash Table Contents (Size %d) ---\n", tableSize);
+    for (int i = 0; i < tableSize; ++i) {
         printf("Index %2d: ", i);
         if (hashTable[i] == EMPTY_SLOT) {
             printf("EMPTY\n");
@@ -115,27 +491,267 @@ void displayTable() {
     printf("---------------------------------------\n");
 }
 
+// --- Benchmark ---
+
+static unsigned long long rngState = 88172645463325252ULL;
+static int nextKey(void) {
+    rngState ^= rngState << 13; rngState ^= rngState >> 7; rngState ^= rngState << 17;
+    return (int)(rngState & 0x7fffffff);
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Fills a table of 'size' slots to 50% load and compares one-at-a-time
+// search() against lookup_batch() over a sweep of batch sizes.
+void runBenchmark(int size, int lookups) {
+    initTable(size);
+    int numKeys = size / 2;
+    int *keys = (int *)malloc((size_t)numKeys * sizeof(int));
+    for (int i = 0; i < numKeys; i++) {
+        keys[i] = nextKey();
+        insert(keys[i]);
+    }
+
+    int *probe = (int *)malloc((size_t)lookups * sizeof(int));
+    int *out = (int *)malloc((size_t)lookups * sizeof(int));
+    for (int i = 0; i < lookups; i++)
+        probe[i] = (i & 1) ? keys[nextKey() % numKeys] : nextKey();
+
+    printf("--- Linear Probing Lookup Benchmark (%d slots = %.1f MB, %d lookups) ---\n",
+           size, size * sizeof(int) / 1048576.0, lookups);
+
+    double start = nowSeconds();
+    int hits = 0;
+    for (int i = 0; i < lookups; i++)
+        hits += search(probe[i]) >= 0;
+    double single = nowSeconds() - start;
+    printf("  one at a time   : %7.2f Mlookups/s (%d hits)\n", lookups / single / 1e6, hits);
+
+    int batchSizes[] = {1, 8, 16, 64, 128, 256, 512, 1024};
+    for (int b = 0; b < (int)(sizeof(batchSizes) / sizeof(batchSizes[0])); b++) {
+        int batch = batchSizes[b];
+        hits = 0;
+        start = nowSeconds();
+        for (int i = 0; i < lookups; i += batch)
+            hits += lookup_batch(probe + i, lookups - i < batch ? lookups - i : batch, out + i);
+        double elapsed = nowSeconds() - start;
+        printf("  batch %4d      : %7.2f Mlookups/s (%.2fx)\n",
+               batch, lookups / elapsed / 1e6, single / elapsed);
+    }
+
+    free(out); free(probe); free(keys);
+}
+
+/**
+ * Compares the two ways of getting a ready-to-query table at startup:
+ * rebuilding it by inserting every key versus mapping a saved snapshot.
+ * Reports startup time and the latency of the first lookup after each.
+ */
+void runSnapshotBenchmark(int size, const char *path, int threads) {
+    int numKeys = size / 2;
+    int *keys = (int *)malloc((size_t)numKeys * sizeof(int));
+    for (int i = 0; i < numKeys; i++)
+        keys[i] = nextKey();
+    int probeKey = keys[numKeys / 3];
+
+    printf("--- Snapshot Benchmark (%d slots = %.1f MB, %d keys) ---\n",
+           size, size * sizeof(int) / 1048576.0, numKeys);
+
+    // Startup path 1: rebuild from scratch, one insert() at a time
+    double start = nowSeconds();
+    initTable(size);
+    for (int i = 0; i < numKeys; i++)
+        insert(keys[i]);
+    double rebuild = nowSeconds() - start;
+    start = nowSeconds();
+    int found = search(probeKey) >= 0;
+    double firstRebuilt = nowSeconds() - start;
+    printf("  sequential rebuild : %10.3f ms   first query %8.2f us (%s)\n",
+           rebuild * 1e3, firstRebuilt * 1e6, found ? "hit" : "miss");
+
+    // Parallel build, then write the snapshot
+    start = nowSeconds();
+    initTable(size);
+    buildParallel(keys, numKeys, threads);
+    double parallel = nowSeconds() - start;
+    printf("  parallel build (%2d): %10.3f ms\n", threads, parallel * 1e3);
+
+    start = nowSeconds();
+    if (saveSnapshot(path) != 0) {
+        printf("Could not write snapshot to %s\n", path);
+        free(keys);
+        return;
+    }
+    printf("  snapshot save      : %10.3f ms -> %s\n", (nowSeconds() - start) * 1e3, path);
+    releaseTable();
+
+    // Startup path 2: map the snapshot
+    start = nowSeconds();
+    if (loadSnapshot(path) != 0) {
+        printf("Could not load snapshot from %s\n", path);
+        free(keys);
+        return;
+    }
+    double load = nowSeconds() - start;
+    start = nowSeconds();
+    found = search(probeKey) >= 0;
+    double firstMapped = nowSeconds() - start;
+    printf("  snapshot mmap load : %10.3f ms   first query %8.2f us (%s)\n",
+           load * 1e3, firstMapped * 1e6, found ? "hit" : "miss");
+
+    int missing = 0;
+    for (int i = 0; i < numKeys; i++)
+        missing += search(keys[i]) < 0;
+    printf("  verification       : %d of %d keys missing from the mapped table\n", missing, numKeys);
+    printf("  startup speedup    : %.0fx\n", rebuild / (load + firstMapped));
+
+    releaseTable();
+    free(keys);
+}
+
+/**
+ * Measures search() with and without the Bloom filter at miss ratios from
+ * 0% to 99%, on a table at 50% load. Also reports the observed false-positive
+ * rate against the configured one.
+ */
+void runBloomBenchmark(int size, int lookups, double fpr) {
+    int numKeys = size / 2;
+    int *keys = (int *)malloc((size_t)numKeys * sizeof(int));
+    int *probe = (int *)malloc((size_t)lookups * sizeof(int));
+
+    disableFilter();
+    initTable(size);
+    for (int i = 0; i < numKeys; i++) {
+        keys[i] = nextKey();
+        insert(keys[i]);
+    }
+
+    printf("--- Bloom Filter Benchmark (%d slots, %d keys, %d lookups, target FPR %.3f) ---\n",
+           size, numKeys, lookups, fpr);
+    printf("  (the filter is sized for a full table, so at 50%% load its FPR is below target)\n");
+    printf("  miss ratio   no filter (Mlookups/s)   filter (Mlookups/s)   speedup   observed FPR\n");
+
+    int missPercents[] = {0, 25, 50, 75, 90, 99};
+    for (int m = 0; m < (int)(sizeof(missPercents) / sizeof(missPercents[0])); m++) {
+        int absent = 0;
+        for (int i = 0; i < lookups; i++) {
+            if ((int)(nextKey() % 100) < missPercents[m]) {
+                do { probe[i] = nextKey(); } while (search(probe[i]) >= 0);
+                absent++;
+            } else {
+                probe[i] = keys[nextKey() % numKeys];
+            }
+        }
+
+        disableFilter();
+        double start = nowSeconds();
+        int hits = 0;
+        for (int i = 0; i < lookups; i++)
+            hits += search(probe[i]) >= 0;
+        double plain = nowSeconds() - start;
+
+        enableFilter(fpr);
+        int falsePositives = 0;
+        for (int i = 0; i < lookups; i++)
+            falsePositives += search(probe[i]) < 0 && bloomMayContain(&keyFilter, probe[i]);
+        start = nowSeconds();
+        int filteredHits = 0;
+        for (int i = 0; i < lookups; i++)
+            filteredHits += search(probe[i]) >= 0;
+        double filtered = nowSeconds() - start;
+
+        printf("  %8d%%   %22.2f   %19.2f   %6.2fx   %10.4f%s\n",
+               missPercents[m], lookups / plain / 1e6, lookups / filtered / 1e6, plain / filtered,
+               absent ? (double)falsePositives / absent : 0.0,
+               hits == filteredHits ? "" : "  (MISMATCH)");
+    }
+
+    disableFilter();
+    free(probe);
+    free(keys);
+}
+
+// Demo helper: inserts a key and reports where it landed
+void insertAndReport(int key) {
+    int slot;
+    switch (insertAt(key, &slot)) {
+        case INSERT_OK:
+            printf("Inserted %d at index %d\n", key, slot);
+            break;
+        case INSERT_DUPLICATE:
+            printf("Key %d already exists at index %d (No insert)\n", key, slot);
+            break;
+        default:
+            printf("Hash Table is full! Cannot insert %d\n", key);
+    }
+}
+
 // --- Main Driver Program ---
-int main() {
-    // Initialize the hash table: all slots are EMPTY_SLOT
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        hashTable[i] = EMPTY_SLOT;
+// Build:  gcc -O2 -march=native hashing.c -o hashing -lm -pthread
+// Usage: ./hashing                     (demo)
+//        ./hashing bench [slots] [lookups]
+//        ./hashing snapshot-bench [slots] [file] [threads]
+//        ./hashing bloom-bench [slots] [lookups] [fpr]
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bloom-bench") == 0) {
+        int slots = argc > 2 ? atoi(argv[2]) : 1 << 24;
+        int lookups = argc > 3 ? atoi(argv[3]) : 2000000;
+        double fpr = argc > 4 ? atof(argv[4]) : 0.01;
+        runBloomBenchmark(slots, lookups, fpr);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        int slots = argc > 2 ? atoi(argv[2]) : 1 << 27;
+        int lookups = argc > 3 ? atoi(argv[3]) : 4000000;
+        runBenchmark(slots, lookups);
+        return 0;
     }
+    if (argc > 1 && strcmp(argv[1], "snapshot-bench") == 0) {
+        int slots = argc > 2 ? atoi(argv[2]) : 1 << 26;
+        const char *path = argc > 3 ? argv[3] : "hashing.snap";
+        int threads = argc > 4 ? atoi(argv[4]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        runSnapshotBenchmark(slots, path, threads);
+        return 0;
+    }
+
+    // Initialize the hash table: all slots are EMPTY_SLOT
+    initTable(TABLE_SIZE);
 
     printf("Starting Hash Table Operations:\n");
 
     // Example keys to insert
-    insert(44); // 44*44 = 1936. Middle digit is 9. Hash: 9
-    insert(12); // 12*12 = 144. Middle digit is 4. Hash: 4
-    insert(23); // 23*23 = 529. Middle digit is 2. Hash: 2
-    insert(10); // 10*10 = 100. Middle digit is 0. Hash: 0
-    insert(43); // 43*43 = 1849. Middle digit is 8. Hash: 8
+    insertAndReport(44); // 44*44 = 1936. Middle digit is 9. Hash: 9
+    insertAndReport(12); // 12*12 = 144. Middle digit is 4. Hash: 4
+    insertAndReport(23); // 23*23 = 529. Middle digit is 2. Hash: 2
+    insertAndReport(10); // 10*10 = 100. Middle digit is 0. Hash: 0
+    insertAndReport(43); // 43*43 = 1849. Middle digit is 8. Hash: 8
     
     // Collision Example:
-    insert(13); // 13*13 = 169. Middle digit is 6. Hash: 6
-    insert(36); // 36*36 = 1296. Middle digit is 9. Collision at index 9! Probes to 0 (full!), then 1. Hash: 1
+    insertAndReport(13); // 13*13 = 169. Middle digit is 6. Hash: 6
+    insertAndReport(36); // 36*36 = 1296. Middle digit is 9. Collision at index 9! Probes to 0 (full!), then 1. Hash: 1
 
     displayTable();
 
+    // Batched lookup of present and absent keys
+    int queries[] = {36, 44, 99, 13};
+    int slots[4];
+    lookup_batch(queries, 4, slots);
+    for (int i = 0; i < 4; ++i)
+        printf("Search %d: %s\n", queries[i], slots[i] >= 0 ? "FOUND" : "NOT FOUND");
+
+    STAT(printf("\n--- Telemetry ---\n"); printStatsJson(stdout));
+
+    // Round-trip the table through a snapshot file and query the mapped copy
+    if (saveSnapshot("hashing.snap") == 0 && loadSnapshot("hashing.snap") == 0) {
+        printf("\nReloaded snapshot: %d keys in %d slots (read-only)\n", keyCount, tableSize);
+        printf("Search 36 in snapshot: %s\n", search(36) >= 0 ? "FOUND" : "NOT FOUND");
+        remove("hashing.snap");
+    }
+
+    releaseTable();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,435 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+// --- Configuration ---
+#define BUCKET_SLOTS 4          // 4-way buckets: 4 ints = 16 bytes, never straddles a cache line
+#define EMPTY_SLOT -1            // Marks a free slot, so -1 itself cannot be stored
+#define MAX_BFS_NODES 512       // Upper bound on buckets explored per insertion path search
+#define MAX_PATH_DEPTH 5        // Longest displacement chain tried before giving up
+#define MAX_REHASH_ATTEMPTS 8   // Re-seed this many times before doubling the table
+#define MAX_LOAD_PERCENT 95     // 4-way cuckoo fills reliably up to ~95%; beyond that, grow
+
+// A bucket holds up to BUCKET_SLOTS keys. Buckets are 16-byte aligned inside a
+// 64-byte aligned array, so every bucket lives in exactly one cache line and a
+// lookup (at most two buckets) touches at most two cache lines.
+typedef struct {
+    int keys[BUCKET_SLOTS];
+} Bucket;
+
+typedef struct {
+    Bucket *buckets;
+    unsigned numBuckets;        // Always a power of two
+    unsigned mask;
+    unsigned count;
+    uint64_t seed1, seed2;
+    int rehashCount;
+} CuckooTable;
+
+// --- Optional Telemetry (compile with -DHASH_STATS) ---
+// Without HASH_STATS every STAT(...) expands to nothing.
+#ifdef HASH_STATS
+#define STAT(x) x
+
+typedef struct {
+    unsigned long long pathLength[MAX_PATH_DEPTH + 1]; // Keys displaced per successful insert
+    unsigned long long inserts, duplicates, failedPaths;
+    unsigned long long hits, misses;
+    unsigned long long resizes;                        // Rehashes that doubled the table
+} HashStats;
+
+HashStats stats;
+static int rebuilding; // Set while rehash() re-places existing keys; those are not inserts
+#define PLACE_STAT(x) do { if (!rebuilding) { x; } } while (0)
+#else
+#define STAT(x)
+#define PLACE_STAT(x)
+#endif
+
+// One step of a displacement path found by the BFS
+typedef struct {
+    unsigned bucket;
+    int slot;       // Slot in 'bucket' whose key moves on (-1 for the start buckets)
+    int parent;     // Index of the previous step in the BFS queue (-1 for roots)
+} PathNode;
+
+// --- Hash Functions ---
+
+// 64-bit finalizer (splitmix64) mixed with a per-table seed
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static unsigned hash1(const CuckooTable *t, int key) {
+    return (unsigned)mix64((uint64_t)(uint32_t)key ^ t->seed1) & t->mask;
+}
+
+static unsigned hash2(const CuckooTable *t, int key) {
+    unsigned h = (unsigned)mix64((uint64_t)(uint32_t)key ^ t->seed2) & t->mask;
+    // Keep the two candidate buckets distinct whenever the table has more than one
+    if (h == hash1(t, key) && t->numBuckets > 1)
+        h = (h + 1) & t->mask;
+    return h;
+}
+
+// The alternate bucket of a key currently stored in bucket 'b'
+static unsigned altBucket(const CuckooTable *t, int key, unsigned b) {
+    unsigned b1 = hash1(t, key);
+    return (b == b1) ? hash2(t, key) : b1;
+}
+
+// --- Table Management ---
+
+static Bucket *allocBuckets(unsigned numBuckets) {
+    size_t bytes = (size_t)numBuckets * sizeof(Bucket);
+    if (bytes < 64) bytes = 64;
+    Bucket *b = (Bucket *)aligned_alloc(64, (bytes + 63) & ~(size_t)63);
+    if (b == NULL) {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
+    memset(b, 0xff, bytes); // Every slot becomes EMPTY_SLOT (-1)
+    return b;
+}
+
+void cuckooInit(CuckooTable *t, unsigned numBuckets) {
+    unsigned n = 1;
+    while (n < numBuckets) n <<= 1;
+    t->numBuckets = n;
+    t->mask = n - 1;
+    t->count = 0;
+    t->seed1 = 0x9e3779b97f4a7c15ULL;
+    t->seed2 = 0xc2b2ae3d27d4eb4fULL;
+    t->rehashCount = 0;
+    t->buckets = allocBuckets(n);
+}
+
+void cuckooFree(CuckooTable *t) {
+    free(t->buckets);
+    t->buckets = NULL;
+}
+
+// --- Lookup: touches at most two buckets (two cache lines) ---
+// EMPTY_SLOT is never stored, so it is never found (it would otherwise
+// match any free slot in either bucket)
+static int cuckooContains(const CuckooTable *t, int key) {
+    if (key == EMPTY_SLOT) return 0;
+    const Bucket *b1 = &t->buckets[hash1(t, key)];
+    const Bucket *b2 = &t->buckets[hash2(t, key)];
+    int found = 0;
+    // Branch-free scan of both buckets; no early exit keeps latency flat
+    for (int s = 0; s < BUCKET_SLOTS; s++)
+        found |= (b1->keys[s] == key) | (b2->keys[s] == key);
+    return found;
+}
+
+int cuckooSearch(const CuckooTable *t, int key) {
+    int found = cuckooContains(t, key);
+    STAT(if (found) stats.hits++; else stats.misses++);
+    return found;
+}
+
+static int freeSlot(const Bucket *b) {
+    for (int s = 0; s < BUCKET_SLOTS; s++)
+        if (b->keys[s] == EMPTY_SLOT) return s;
+    return -1;
+}
+
+// --- BFS Insertion Path Search ---
+/**
+ * Searches breadth-first from both candidate buckets of 'key' for a bucket
+ * with a free slot, then shifts keys backwards along the shortest path found.
+ * Returns 1 on success, 0 if no path exists within the search limits.
+ */
+static int placeKey(CuckooTable *t, int key) {
+    unsigned b1 = hash1(t, key), b2 = hash2(t, key);
+    int s;
+
+    if ((s = freeSlot(&t->buckets[b1])) >= 0) { t->buckets[b1].keys[s] = key; t->count++; PLACE_STAT(stats.pathLength[0]++); return 1; }
+    if ((s = freeSlot(&t->buckets[b2])) >= 0) { t->buckets[b2].keys[s] = key; t->count++; PLACE_STAT(stats.pathLength[0]++); return 1; }
+
+    PathNode queue[MAX_BFS_NODES];
+    int depth[MAX_BFS_NODES];
+    int head = 0, tail = 0;
+    queue[tail] = (PathNode){ b1, -1, -1 }; depth[tail++] = 0;
+    queue[tail] = (PathNode){ b2, -1, -1 }; depth[tail++] = 0;
+
+    while (head < tail) {
+        int cur = head++;
+        if (depth[cur] >= MAX_PATH_DEPTH) continue;
+        const Bucket *bk = &t->buckets[queue[cur].bucket];
+
+        for (s = 0; s < BUCKET_SLOTS && tail < MAX_BFS_NODES; s++) {
+            unsigned next = altBucket(t, bk->keys[s], queue[cur].bucket);
+
+            // A path that revisits a bucket could move the same slot twice
+            int onPath = 0;
+            for (int a = cur; a >= 0 && !onPath; a = queue[a].parent)
+                onPath = (queue[a].bucket == next);
+            if (onPath) continue;
+
+            queue[tail] = (PathNode){ next, s, cur };
+            depth[tail] = depth[cur] + 1;
+            int open = freeSlot(&t->buckets[next]);
+            if (open < 0) { tail++; continue; }
+
+            // Walk the path back to a root, moving each key one hop forward
+            int node = tail, dst = open;
+            while (queue[node].parent >= 0) {
+                int from = queue[node].parent;
+                Bucket *src = &t->buckets[queue[from].bucket];
+                t->buckets[queue[node].bucket].keys[dst] = src->keys[queue[node].slot];
+                dst = queue[node].slot;
+                node = from;
+            }
+            t->buckets[queue[node].bucket].keys[dst] = key;
+            t->count++;
+            PLACE_STAT(stats.pathLength[depth[tail]]++);
+            return 1;
+        }
+    }
+    PLACE_STAT(stats.failedPaths++);
+    return 0;
+}
+
+// Rebuilds the table with fresh seeds, doubling it if re-seeding keeps failing.
+// Re-seeding only helps below the achievable load; at or above it the table
+// doubles straight away instead of paying for rebuilds that cannot succeed.
+static void rehash(CuckooTable *t, int pendingKey) {
+    Bucket *old = t->buckets;
+    unsigned oldBuckets = t->numBuckets;
+    unsigned long long keys = (unsigned long long)t->count + 1;
+    int attempts = 0;
+
+    for (;;) {
+        int overloaded = keys * 100 >= (unsigned long long)t->numBuckets * BUCKET_SLOTS * MAX_LOAD_PERCENT;
+        if (overloaded || attempts++ >= MAX_REHASH_ATTEMPTS) {
+            t->numBuckets <<= 1;
+            t->mask = t->numBuckets - 1;
+            attempts = 0;
+            STAT(stats.resizes++);
+        }
+        t->seed1 = mix64(t->seed1 + 1);
+        t->seed2 = mix64(t->seed2 + 1);
+        t->buckets = allocBuckets(t->numBuckets);
+        t->count = 0;
+        t->rehashCount++;
+
+        int ok = placeKey(t, pendingKey);
+        // Re-placing the old keys is rehash traffic, not insert displacement
+        STAT(rebuilding = 1);
+        for (unsigned b = 0; ok && b < oldBuckets; b++)
+            for (int s = 0; ok && s < BUCKET_SLOTS; s++)
+                if (old[b].keys[s] != EMPTY_SLOT)
+                    ok = placeKey(t, old[b].keys[s]);
+        STAT(rebuilding = 0);
+        if (ok) break;
+        free(t->buckets);
+    }
+    free(old);
+}
+
+// --- Insertion ---
+// Returns 1 if inserted, 0 if the key was already present, -1 if the key
+// is EMPTY_SLOT, which marks free slots and cannot be stored.
+int cuckooInsert(CuckooTable *t, int key) {
+    if (key == EMPTY_SLOT) return -1;
+    if (cuckooContains(t, key)) {
+        STAT(stats.duplicates++);
+        return 0;
+    }
+    if (!placeKey(t, key)) rehash(t, key);
+    STAT(stats.inserts++);
+    return 1;
+}
+
+#ifdef HASH_STATS
+// --- Telemetry Export ---
+// Writes the collected statistics as a single JSON object
+void printStatsJson(FILE *fp, const CuckooTable *t) {
+    unsigned capacity = t->numBuckets * BUCKET_SLOTS;
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"table\": \"cuckoo_4way\",\n");
+    fprintf(fp, "  \"buckets\": %u,\n", t->numBuckets);
+    fprintf(fp, "  \"keys\": %u,\n", t->count);
+    fprintf(fp, "  \"load_factor\": %.4f,\n", (double)t->count / capacity);
+    fprintf(fp, "  \"inserts\": %llu,\n", stats.inserts);
+    fprintf(fp, "  \"duplicates\": %llu,\n", stats.duplicates);
+    fprintf(fp, "  \"hits\": %llu,\n", stats.hits);
+    fprintf(fp, "  \"misses\": %llu,\n", stats.misses);
+    fprintf(fp, "  \"failed_path_searches\": %llu,\n", stats.failedPaths);
+    fprintf(fp, "  \"rehashes\": %d,\n", t->rehashCount);
+    fprintf(fp, "  \"resizes\": %llu,\n", stats.resizes);
+    fprintf(fp, "  \"displacement_histogram\": [");
+    for (int i = 0; i <= MAX_PATH_DEPTH; i++)
+        fprintf(fp, "%s%llu", i ? ", " : "", stats.pathLength[i]);
+    fprintf(fp, "]\n}\n");
+}
+#endif
+
+// --- Display Function ---
+void displayTable(const CuckooTable *t) {
+    printf("\n--- Cuckoo Hash Table (%u buckets x %d slots, %u keys) ---\n",
+           t->numBuckets, BUCKET_SLOTS, t->count);
+    for (unsigned b = 0; b < t->numBuckets; b++) {
+        printf("Bucket %2u: ", b);
+        for (int s = 0; s < BUCKET_SLOTS; s++) {
+            if (t->buckets[b].keys[s] == EMPTY_SLOT) printf("  -  ");
+            else printf("%4d ", t->buckets[b].keys[s]);
+        }
+        printf("\n");
+    }
+    printf("Rehashes: %d\n", t->rehashCount);
+    printf("---------------------------------------\n");
+}
+
+// --- Benchmark ---
+
+static uint64_t rngState = 88172645463325252ULL;
+static uint32_t nextRandom(void) {
+    rngState ^= rngState << 13; rngState ^= rngState >> 7; rngState ^= rngState << 17;
+    return (uint32_t)rngState;
+}
+
+static long long nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int compareLL(const void *a, const void *b) {
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+// Linear probing baseline (same layout as hashing.c) for tail-latency comparison
+static int linearSearch(const int *table, unsigned mask, uint64_t seed, int key) {
+    unsigned i = (unsigned)mix64((uint64_t)(uint32_t)key ^ seed) & mask;
+    while (table[i] != EMPTY_SLOT) {
+        if (table[i] == key) return 1;
+        i = (i + 1) & mask;
+    }
+    return 0;
+}
+
+static void reportLatency(const char *name, long long *lat, int n, long long timerCost) {
+    qsort(lat, n, sizeof(long long), compareLL);
+    long long p50 = lat[n / 2] - timerCost, p99 = lat[(long long)n * 99 / 100] - timerCost;
+    long long p999 = lat[(long long)n * 999 / 1000] - timerCost, max = lat[n - 1] - timerCost;
+    printf("  %-16s p50 %5lld ns   p99 %5lld ns   p999 %6lld ns   max %7lld ns\n",
+           name, p50, p99, p999, max);
+}
+
+void runBenchmark(unsigned numBuckets, int lookups) {
+    unsigned capacity;
+    printf("--- Cuckoo Hashing Benchmark (%u buckets x %d slots) ---\n", numBuckets, BUCKET_SLOTS);
+
+    // 1. Maximum achievable load factor: fill a fixed-size table until the
+    //    BFS path search first fails (no rehash, no growth).
+    CuckooTable t;
+    cuckooInit(&t, numBuckets);
+    capacity = t.numBuckets * BUCKET_SLOTS;
+    while (placeKey(&t, (int)(nextRandom() & 0x7fffffff)))
+        ;
+    printf("Max load factor before first failed insertion: %.4f (%u / %u)\n",
+           (double)t.count / capacity, t.count, capacity);
+    cuckooFree(&t);
+
+    // 2. Lookup latency at 90% load, half hits / half misses
+    unsigned n = (unsigned)(capacity * 0.90);
+    int *keys = (int *)malloc(n * sizeof(int));
+    cuckooInit(&t, numBuckets);
+    for (unsigned i = 0; i < n; i++) {
+        keys[i] = (int)(nextRandom() & 0x7fffffff);
+        cuckooInsert(&t, keys[i]);
+    }
+
+    unsigned lmask = 1;
+    while (lmask < capacity) lmask <<= 1;
+    int *linear = (int *)malloc(lmask * sizeof(int));
+    memset(linear, 0xff, lmask * sizeof(int));
+    uint64_t lseed = 0x9e3779b97f4a7c15ULL;
+    lmask -= 1;
+    for (unsigned i = 0; i < n; i++) {
+        unsigned j = (unsigned)mix64((uint64_t)(uint32_t)keys[i] ^ lseed) & lmask;
+        while (linear[j] != EMPTY_SLOT && linear[j] != keys[i]) j = (j + 1) & lmask;
+        linear[j] = keys[i];
+    }
+
+    int *probe = (int *)malloc(lookups * sizeof(int));
+    for (int i = 0; i < lookups; i++)
+        probe[i] = (i & 1) ? keys[nextRandom() % n] : (int)(nextRandom() & 0x7fffffff);
+
+    long long *lat = (long long *)malloc(lookups * sizeof(long long));
+    long long timerCost = 1000000;
+    for (int i = 0; i < 1000; i++) {   // Cheapest back-to-back timer pair
+        long long start = nowNs(), d = nowNs() - start;
+        if (d < timerCost) timerCost = d;
+    }
+    volatile int sink = 0;
+
+    printf("Lookup latency at load %.2f (%d lookups, ~50%% hits, timer cost %lld ns subtracted):\n",
+           (double)n / capacity, lookups, timerCost);
+    for (int i = 0; i < lookups; i++) {
+        long long start = nowNs();
+        sink += cuckooSearch(&t, probe[i]);
+        lat[i] = nowNs() - start;
+    }
+    reportLatency("cuckoo (4-way)", lat, lookups, timerCost);
+    for (int i = 0; i < lookups; i++) {
+        long long start = nowNs();
+        sink += linearSearch(linear, lmask, lseed, probe[i]);
+        lat[i] = nowNs() - start;
+    }
+    reportLatency("linear probing", lat, lookups, timerCost);
+    printf("Rehashes during build: %d\n", t.rehashCount);
+
+    free(lat); free(probe); free(linear); free(keys);
+    cuckooFree(&t);
+}
+
+// --- Main Driver Program ---
+// Usage: ./hashing_cuckoo              (demo)
+//        ./hashing_cuckoo bench [buckets] [lookups]
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        unsigned buckets = argc > 2 ? (unsigned)strtoul(argv[2], NULL, 10) : 1u << 20;
+        int lookups = argc > 3 ? atoi(argv[3]) : 1000000;
+        runBenchmark(buckets, lookups);
+        return 0;
+    }
+
+    CuckooTable t;
+    cuckooInit(&t, 4);
+
+    printf("Starting Cuckoo Hash Table Operations:\n");
+
+    // Same keys as hashing.c, plus enough extra to force displacements and a rehash
+    int keys[] = {44, 12, 23, 10, 43, 13, 36, 7, 91, 58, 65, 29, 81, 3, 77, 50, 19, 62};
+    int numKeys = sizeof(keys) / sizeof(keys[0]);
+    for (int i = 0; i < numKeys; i++) {
+        int result = cuckooInsert(&t, keys[i]);
+        if (result > 0)
+            printf("Inserted %d\n", keys[i]);
+        else if (result == 0)
+            printf("Key %d already exists (No insert)\n", keys[i]);
+        else
+            printf("Key %d is reserved for empty slots (No insert)\n", keys[i]);
+    }
+
+    displayTable(&t);
+
+    printf("Search 36: %s\n", cuckooSearch(&t, 36) ? "FOUND" : "NOT FOUND");
+    printf("Search 99: %s\n", cuckooSearch(&t, 99) ? "FOUND" : "NOT FOUND");
+
+    STAT(printf("\n--- Telemetry ---\n"); printStatsJson(stdout, &t));
+
+    cuckooFree(&t);
+    return 0;
+}
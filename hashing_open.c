@@ -1,9 +1,13 @@
+#define _POSIX_C_SOURCE 199309L
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 // --- Configuration ---
-#define TABLE_SIZE 10 // The divisor 'm' for the hash function
+#define TABLE_SIZE 10 // The divisor 'm' used by the demo in main()
 #define EMPTY 0       // Value to indicate an empty slot (for simplicity, assuming keys are positive)
+#define PREFETCH_GROUP 16 // Keys hashed and prefetched together by lookup_batch()
 
 // --- Structure for the Linked List (Chaining) ---
 struct Node {
@@ -11,84 +15,236 @@ struct Node {
     struct Node* next;
 };
 
-// Global Hash Table Array (Array of linked list pointers/heads)
-struct Node* hashTable[TABLE_SIZE];
+// Global Hash Table Array (Array of linked list pointers/heads), sized by initTable()
+struct Node** hashTable = NULL;
+int tableSize = 0;
 
 // Global collision counter
 int collisionCount = 0;
+int keyCount = 0;
+
+// Status codes returned by insert()
+#define INSERT_OK 0
+#define INSERT_DUPLICATE 1
+#define INSERT_ERROR -1
+
+// --- Optional Telemetry (compile with -DHASH_STATS) ---
+// Without HASH_STATS every STAT(...) expands to nothing, so the insert and
+// lookup paths are exactly the uninstrumented code.
+#ifdef HASH_STATS
+#define STAT(x) x
+#define HIST_BUCKETS 33 // Lengths 0..31; the last bucket counts 32 and longer
+
+typedef struct {
+    unsigned long long insertChainWalk[HIST_BUCKETS]; // Nodes passed before appending
+    unsigned long long lookupChainWalk[HIST_BUCKETS]; // Nodes compared per lookup
+    unsigned long long inserts, duplicates;
+    unsigned long long hits, misses;
+} HashStats;
+
+HashStats stats;
+
+static void recordLength(unsigned long long* hist, int length) {
+    hist[length < HIST_BUCKETS - 1 ? length : HIST_BUCKETS - 1]++;
+}
+#else
+#define STAT(x)
+#endif
 
 // --- 1. Division Hash Function ---
 /**
  * Calculates the hash index using the Division Method: h(k) = k mod m
  */
 int divisionHash(int key) {
-    return key % TABLE_SIZE;
+    return key % tableSize;
+}
+
+/**
+ * Allocates 'size' empty buckets (all chains NULL).
+ */
+void initTable(int size) {
+    hashTable = (struct Node**)calloc((size_t)size, sizeof(struct Node*));
+    if (hashTable == NULL) {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
+    tableSize = size;
+}
+
+/**
+ * Frees every chain and the bucket array.
+ */
+void freeTable() {
+    for (int i = 0; i < tableSize; ++i) {
+        struct Node* current = hashTable[i];
+        while (current != NULL) {
+            struct Node* temp = current;
+            current = current->next;
+            free(temp);
+        }
+    }
+    free(hashTable);
+    hashTable = NULL;
+    tableSize = 0;
+    keyCount = 0;
 }
 
 // --- 2. Insertion using Open Hashing (Chaining) ---
 /**
  * Inserts a key into the hash table, resolving collisions via chaining.
+ * Returns INSERT_OK, INSERT_DUPLICATE or INSERT_ERROR (non-positive key or
+ * allocation failure). Does no I/O, so it is safe for bulk loading.
  */
-void insert(int key) {
-    if (key <= 0) {
-        printf("Error: Key must be positive.\n");
-        return;
-    }
+int insert(int key) {
+    if (key <= 0) return INSERT_ERROR;
 
     // Calculate the index
     int index = divisionHash(key);
 
+    // Traverse to the end of the chain, rejecting duplicates on the way
+    struct Node** link = &hashTable[index];
+    STAT(int chainLength = 0);
+    while (*link != NULL) {
+        if ((*link)->key == key) {
+            STAT(stats.duplicates++);
+            return INSERT_DUPLICATE;
+        }
+        link = &(*link)->next;
+        STAT(chainLength++);
+    }
+
     // Create a new node for the key
     struct Node* newNode = (struct Node*)malloc(sizeof(struct Node));
-    if (newNode == NULL) {
-        printf("Memory allocation failed!\n");
-        return;
-    }
+    if (newNode == NULL) return INSERT_ERROR;
     newNode->key = key;
     newNode->next = NULL;
 
-    printf("\nInserting Key %d:\n", key);
-    printf("  1. Hash Index calculated: %d\n", index);
-
-    // Check if the slot is empty
-    if (hashTable[index] == NULL) {
-        // No collision, insert as the head
-        hashTable[index] = newNode;
-        printf("  2. Index was EMPTY. Key %d placed as the head of the chain.\n", key);
-    } else {
-        // Collision detected: use chaining
-        printf("  2. **COLLISION** detected at index %d (Current head: %d).\n", index, hashTable[index]->key);
-        
-        // Step-by-step resolution: Traverse to the end of the list and append
-        struct Node* current = hashTable[index];
-        struct Node* previous = NULL;
-        int chainLength = 0;
-        
-        // Traverse to the end of the chain
-        while (current != NULL) {
-            if (current->key == key) {
-                printf("  Key %d already exists. Skipping insertion.\n", key);
-                free(newNode);
-                return;
+    // A collision occurred if we had to chain behind an existing head
+    if (link != &hashTable[index]) collisionCount++;
+    *link = newNode;
+    keyCount++;
+    STAT(stats.inserts++; recordLength(stats.insertChainWalk, chainLength));
+    return INSERT_OK;
+}
+
+// --- 3. Search ---
+/**
+ * Walks the chain of the key's bucket. Returns the bucket index or -1.
+ */
+int search(int key) {
+    if (key <= 0) return -1;
+    int index = divisionHash(key);
+    STAT(int walked = 0);
+    for (struct Node* current = hashTable[index]; current != NULL; current = current->next) {
+        STAT(walked++);
+        if (current->key == key) {
+            STAT(stats.hits++; recordLength(stats.lookupChainWalk, walked));
+            return index;
+        }
+    }
+    STAT(stats.misses++; recordLength(stats.lookupChainWalk, walked));
+    return -1;
+}
+
+// --- 4. Batched Search with Software Prefetching ---
+/**
+ * Looks up keys[0..n-1], writing each key's bucket index (or -1) to out[i].
+ * Each group of PREFETCH_GROUP keys goes through three passes so the cache
+ * misses of the whole group overlap instead of being taken one by one:
+ *   1. hash every key and prefetch its bucket head pointer,
+ *   2. load the heads and prefetch the first chain node,
+ *   3. walk the chains.
+ * Returns the number of keys found.
+ */
+int lookup_batch(const int* keys, int n, int* out) {
+    int index[PREFETCH_GROUP];
+    struct Node* head[PREFETCH_GROUP];
+    int found = 0;
+
+    for (int base = 0; base < n; base += PREFETCH_GROUP) {
+        int g = n - base < PREFETCH_GROUP ? n - base : PREFETCH_GROUP;
+
+        for (int j = 0; j < g; j++) {
+            int key = keys[base + j];
+            index[j] = key > 0 ? divisionHash(key) : -1;
+            if (index[j] >= 0) __builtin_prefetch(&hashTable[index[j]], 0, 0);
+        }
+
+        for (int j = 0; j < g; j++) {
+            head[j] = index[j] >= 0 ? hashTable[index[j]] : NULL;
+            if (head[j] != NULL) __builtin_prefetch(head[j], 0, 0);
+        }
+
+        for (int j = 0; j < g; j++) {
+            int key = keys[base + j];
+            out[base + j] = -1;
+            STAT(int walked = 0);
+            for (struct Node* current = head[j]; current != NULL; current = current->next) {
+                STAT(walked++);
+                if (current->key == key) {
+                    out[base + j] = index[j];
+                    found++;
+                    break;
+                }
             }
-            previous = current;
-            current = current->next;
-            chainLength++;
+            STAT(if (out[base + j] >= 0) stats.hits++; else stats.misses++;
+                 recordLength(stats.lookupChainWalk, walked));
         }
-        
-        // Append the new node to the end of the chain
-        if (previous != NULL) {
-             previous->next = newNode;
-             collisionCount++; // A collision occurred because we had to chain
-             printf("  3. Collision resolved by **CHAINING**. Key %d linked to the end of the chain (length %d).\n", key, chainLength + 1);
+    }
+    return found;
+}
+
+#ifdef HASH_STATS
+// --- Telemetry Export ---
+
+static void printHistogram(FILE* fp, const char* name, const unsigned long long* hist) {
+    int last = HIST_BUCKETS - 1;
+    while (last > 0 && hist[last] == 0) last--; // Trim trailing empty buckets
+    fprintf(fp, "  \"%s\": [", name);
+    for (int i = 0; i <= last; ++i) {
+        fprintf(fp, "%s%llu", i ? ", " : "", hist[i]);
+    }
+    fprintf(fp, "]");
+}
+
+/**
+ * Writes the collected statistics as a single JSON object. The chain-length
+ * histogram is computed here by walking every bucket, so it costs nothing
+ * on the insert/lookup paths.
+ */
+void printStatsJson(FILE* fp) {
+    unsigned long long chainLengths[HIST_BUCKETS] = {0};
+    for (int i = 0; i < tableSize; ++i) {
+        int length = 0;
+        for (struct Node* current = hashTable[i]; current != NULL; current = current->next) {
+            length++;
         }
+        recordLength(chainLengths, length);
     }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"table\": \"chaining\",\n");
+    fprintf(fp, "  \"buckets\": %d,\n", tableSize);
+    fprintf(fp, "  \"keys\": %d,\n", keyCount);
+    fprintf(fp, "  \"load_factor\": %.4f,\n", tableSize ? (double)keyCount / tableSize : 0.0);
+    fprintf(fp, "  \"collisions\": %d,\n", collisionCount);
+    fprintf(fp, "  \"inserts\": %llu,\n", stats.inserts);
+    fprintf(fp, "  \"duplicates\": %llu,\n", stats.duplicates);
+    fprintf(fp, "  \"hits\": %llu,\n", stats.hits);
+    fprintf(fp, "  \"misses\": %llu,\n", stats.misses);
+    printHistogram(fp, "chain_length_histogram", chainLengths);
+    fprintf(fp, ",\n");
+    printHistogram(fp, "insert_walk_histogram", stats.insertChainWalk);
+    fprintf(fp, ",\n");
+    printHistogram(fp, "lookup_walk_histogram", stats.lookupChainWalk);
+    fprintf(fp, "\n}\n");
 }
+#endif
 
 // --- Display Function ---
 void displayTable() {
     printf("\n--- Final Hash Table (Chaining) ---\n");
-    for (int i = 0; i < TABLE_SIZE; ++i) {
+    for (int i = 0; i < tableSize; ++i) {
         printf("Bucket %2d: ", i);
         struct Node* current = hashTable[i];
         if (current == NULL) {
@@ -107,13 +263,77 @@ void displayTable() {
     printf("--------------------------------------\n");
 }
 
+// --- Benchmark ---
+
+static unsigned long long rngState = 88172645463325252ULL;
+static int nextKey() {
+    rngState ^= rngState << 13; rngState ^= rngState >> 7; rngState ^= rngState << 17;
+    return (int)(rngState % 0x7ffffffe) + 1; // Keys must be positive
+}
+
+static double nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Loads 'size' buckets with 'size' keys (load factor 1) and compares
+ * one-at-a-time search() against lookup_batch() over a sweep of batch sizes.
+ */
+void runBenchmark(int size, int lookups) {
+    initTable(size);
+    int* keys = (int*)malloc((size_t)size * sizeof(int));
+    for (int i = 0; i < size; i++) {
+        keys[i] = nextKey();
+        insert(keys[i]);
+    }
+
+    int* probe = (int*)malloc((size_t)lookups * sizeof(int));
+    int* out = (int*)malloc((size_t)lookups * sizeof(int));
+    for (int i = 0; i < lookups; i++)
+        probe[i] = (i & 1) ? keys[nextKey() % size] : nextKey();
+
+    printf("--- Chaining Lookup Benchmark (%d buckets, ~%.1f MB, %d lookups) ---\n",
+           size, size * (sizeof(struct Node*) + sizeof(struct Node)) / 1048576.0, lookups);
+
+    double start = nowSeconds();
+    int hits = 0;
+    for (int i = 0; i < lookups; i++)
+        hits += search(probe[i]) >= 0;
+    double single = nowSeconds() - start;
+    printf("  one at a time   : %7.2f Mlookups/s (%d hits)\n", lookups / single / 1e6, hits);
+
+    int batchSizes[] = {1, 8, 16, 64, 128, 256, 512, 1024};
+    for (int b = 0; b < (int)(sizeof(batchSizes) / sizeof(batchSizes[0])); b++) {
+        int batch = batchSizes[b];
+        start = nowSeconds();
+        for (int i = 0; i < lookups; i += batch)
+            lookup_batch(probe + i, lookups - i < batch ? lookups - i : batch, out + i);
+        double elapsed = nowSeconds() - start;
+        printf("  batch %4d      : %7.2f Mlookups/s (%.2fx)\n",
+               batch, lookups / elapsed / 1e6, single / elapsed);
+    }
+    STAT(printStatsJson(stdout));
+
+    free(out); free(probe); free(keys);
+    freeTable();
+}
+
 // --- Main Function ---
-int main() {
-    // Initialize the hash table pointers to NULL
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        hashTable[i] = NULL;
+// Usage: ./hashing_open                 (demo)
+//        ./hashing_open bench [buckets] [lookups]
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        int buckets = argc > 2 ? atoi(argv[2]) : 1 << 25;
+        int lookups = argc > 3 ? atoi(argv[3]) : 4000000;
+        runBenchmark(buckets, lookups);
+        return 0;
     }
 
+    // Initialize the hash table pointers to NULL
+    initTable(TABLE_SIZE);
+
     // Sample keys for demonstration
     int keys[] = {5, 15, 25, 30, 8, 18, 4};
     int numKeys = sizeof(keys) / sizeof(keys[0]);
@@ -122,23 +342,38 @@ int main() {
 
     // Insert all keys
     for (int i = 0; i < numKeys; ++i) {
-        insert(keys[i]);
+        int index = divisionHash(keys[i]);
+        int chained = hashTable[index] != NULL;
+        switch (insert(keys[i])) {
+            case INSERT_OK:
+                printf("Inserted %d into bucket %d%s\n", keys[i], index,
+                       chained ? " (collision, resolved by chaining)" : "");
+                break;
+            case INSERT_DUPLICATE:
+                printf("Key %d already exists. Skipping insertion.\n", keys[i]);
+                break;
+            default:
+                printf("Error: could not insert %d (key must be positive).\n", keys[i]);
+        }
     }
 
     displayTable();
 
     printf("\n--- Summary ---\n");
     printf("Total Number of Collisions Resolved via Chaining: **%d**\n", collisionCount);
+
+    // Batched lookup of present and absent keys
+    int queries[] = {25, 18, 35, 4};
+    int buckets[4];
+    lookup_batch(queries, 4, buckets);
+    for (int i = 0; i < 4; ++i) {
+        printf("Search %d: %s\n", queries[i], buckets[i] >= 0 ? "FOUND" : "NOT FOUND");
+    }
+
+    STAT(printf("\n--- Telemetry ---\n"); printStatsJson(stdout));
     
     // Free allocated memory (Good practice)
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        struct Node* current = hashTable[i];
-        while (current != NULL) {
-            struct Node* temp = current;
-            current = current->next;
-            free(temp);
-        }
-    }
+    freeTable();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,136 @@
+#ifndef INDEXED_HEAP_HPP
+#define INDEXED_HEAP_HPP
+
+#include <vector>
+#include <functional>
+#include <utility>
+#include <cstdint>
+#include <cassert>
+
+/**
+ * @brief Binary max-heap with stable handles, for priorities that change.
+ *
+ * push() returns a Handle that stays valid until the element is popped or
+ * removed, however the element moves inside the heap. A position map
+ * (handle -> heap slot) makes update_priority(), remove() and contains()
+ * O(log n), O(log n) and O(1) without searching the heap. Handles of
+ * removed elements are recycled.
+ */
+template <typename P, typename Compare = std::less<P>>
+class IndexedHeap {
+public:
+    using Handle = uint32_t;
+
+    IndexedHeap() = default;
+    explicit IndexedHeap(Compare cmp) : cmp(std::move(cmp)) {}
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+
+    bool contains(Handle h) const { return h < pos.size() && pos[h] != NOT_IN_HEAP; }
+
+    const P& priority(Handle h) const {
+        assert(contains(h));
+        return prio[h];
+    }
+
+    // Highest-priority element. Precondition: !empty()
+    Handle topHandle() const {
+        assert(!heap.empty());
+        return heap[0];
+    }
+    const P& top() const { return prio[topHandle()]; }
+
+    Handle push(const P& p) {
+        Handle h;
+        if (!freeHandles.empty()) {
+            h = freeHandles.back();
+            freeHandles.pop_back();
+            prio[h] = p;
+        } else {
+            h = (Handle)prio.size();
+            prio.push_back(p);
+            pos.push_back(NOT_IN_HEAP);
+        }
+        heap.push_back(h);
+        siftUp(heap.size() - 1, h);
+        return h;
+    }
+
+    // Removes the highest-priority element and returns its handle and priority
+    std::pair<Handle, P> pop() {
+        Handle h = topHandle();
+        std::pair<Handle, P> result(h, prio[h]);
+        removeAt(0);
+        return result;
+    }
+
+    // Changes the priority of a queued element and restores heap order
+    void update_priority(Handle h, const P& p) {
+        assert(contains(h));
+        bool up = cmp(prio[h], p);
+        prio[h] = p;
+        if (up) siftUp(pos[h], h);
+        else siftDown(pos[h], h);
+    }
+
+    // Cancels a queued element. Returns false if the handle is not queued.
+    bool remove(Handle h) {
+        if (!contains(h)) return false;
+        removeAt(pos[h]);
+        return true;
+    }
+
+private:
+    static constexpr uint32_t NOT_IN_HEAP = UINT32_MAX;
+
+    std::vector<Handle> heap;       // Heap order, by handle
+    std::vector<uint32_t> pos;      // Handle -> index in 'heap'
+    std::vector<P> prio;            // Handle -> priority
+    std::vector<Handle> freeHandles;
+    Compare cmp;
+
+    void removeAt(size_t i) {
+        Handle gone = heap[i];
+        pos[gone] = NOT_IN_HEAP;
+        freeHandles.push_back(gone);
+
+        Handle last = heap.back();
+        heap.pop_back();
+        if (i == heap.size()) return; // Removed the last slot itself
+
+        // Refill the hole with the last element; it may need to go either way
+        if (i > 0 && cmp(prio[heap[(i - 1) / 2]], prio[last])) siftUp(i, last);
+        else siftDown(i, last);
+    }
+
+    // Places handle h into the hole at i, moving lower-priority parents down
+    void siftUp(size_t i, Handle h) {
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (!cmp(prio[heap[parent]], prio[h])) break;
+            heap[i] = heap[parent];
+            pos[heap[i]] = (uint32_t)i;
+            i = parent;
+        }
+        heap[i] = h;
+        pos[h] = (uint32_t)i;
+    }
+
+    // Places handle h into the hole at i, moving higher-priority children up
+    void siftDown(size_t i, Handle h) {
+        size_t n = heap.size();
+        size_t child;
+        while ((child = 2 * i + 1) < n) {
+            if (child + 1 < n && cmp(prio[heap[child]], prio[heap[child + 1]])) child++;
+            if (!cmp(prio[h], prio[heap[child]])) break;
+            heap[i] = heap[child];
+            pos[heap[i]] = (uint32_t)i;
+            i = child;
+        }
+        heap[i] = h;
+        pos[h] = (uint32_t)i;
+    }
+};
+
+#endif // INDEXED_HEAP_HPP
@@ -1,146 +1,1100 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include "gemm.h"
 
-// Function to allocate memory for a matrix
-int **allocateMatrix(int n) {
-    int **mat = (int **)malloc(n * sizeof(int *));
-    for (int i = 0; i < n; i++)
-        mat[i] = (int *)malloc(n * sizeof(int));
-    return mat;
+// --- Matrix Type ---
+
+#define MATRIX_ALIGN 64 // Bytes; rows start on cache-line boundaries
+
+// Row-major matrix in one contiguous block. Element (i, j) lives at
+// data[i * stride + j]; stride >= cols pads each row to a cache-line multiple.
+typedef struct {
+    int *data;
+    int rows, cols;
+    int stride;
+} Matrix;
+
+#define AT(M, i, j) ((M).data[(size_t)(i) * (M).stride + (j)])
+
+// Function to allocate memory for a matrix (one aligned block, zeroed)
+Matrix allocateMatrix(int rows, int cols) {
+    Matrix m;
+    int perLine = MATRIX_ALIGN / (int)sizeof(int);
+    m.rows = rows;
+    m.cols = cols;
+    m.stride = (cols + perLine - 1) / perLine * perLine;
+    size_t bytes = (size_t)rows * m.stride * sizeof(int);
+    m.data = (int *)aligned_alloc(MATRIX_ALIGN, bytes > 0 ? bytes : MATRIX_ALIGN);
+    if (m.data == NULL) {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
+    memset(m.data, 0, bytes);
+    return m;
 }
 
-// Function to add two matrices
-void addMatrix(int **A, int **B, int **C, int n) {
-    for (int i = 0; i < n; i++)
-        for (int j = 0; j < n; j++)
-            C[i][j] = A[i][j] + B[i][j];
+void freeMatrix(Matrix *m) {
+    free(m->data);
+    m->data = NULL;
 }
 
-// Function to subtract two matrices
-void subMatrix(int **A, int **B, int **C, int n) {
-    for (int i = 0; i < n; i++)
-        for (int j = 0; j < n; j++)
-            C[i][j] = A[i][j] - B[i][j];
+// A rows x cols window of M starting at (i, j), sharing M's storage
+static Matrix view(Matrix M, int i, int j, int rows, int cols) {
+    Matrix v = {&AT(M, i, j), rows, cols, M.stride};
+    return v;
 }
 
-// Recursive Strassen function
-void strassen(int **A, int **B, int **C, int n) {
-    if (n == 1) {
-        C[0][0] = A[0][0] * B[0][0];
-        return;
+// Takes a rows x cols matrix (stride cols) from the front of a workspace
+static Matrix carve(int **workspace, int rows, int cols) {
+    Matrix m = {*workspace, rows, cols, cols};
+    *workspace += (size_t)rows * cols;
+    return m;
+}
+
+// --- Work-Stealing Pool ---
+
+// A C counterpart of work_stealing.hpp, sized for the Strassen recursion:
+// each worker owns a deque, runs its own tasks newest-first and steals the
+// oldest (largest) task from another worker when it runs dry. A thread that
+// waits for its children keeps running tasks meanwhile, so nested parallel
+// levels cannot deadlock. The thread that starts the pool is worker 0.
+
+#define MAX_WORKERS 64
+#define DEQUE_CAPACITY 256      // Per worker; a full deque runs tasks inline
+
+typedef struct {
+    void (*fn)(void *);
+    void *arg;
+    atomic_int *pending;        // Decremented when the task finishes
+} Task;
+
+typedef struct {
+    pthread_mutex_t lock;
+    Task tasks[DEQUE_CAPACITY];
+    unsigned top, bottom;       // Live tasks are [top, bottom), indices mod capacity
+} __attribute__((aligned(64))) Deque;
+
+static struct {
+    int threads;
+    Deque deques[MAX_WORKERS];
+    pthread_t ids[MAX_WORKERS];
+    atomic_int queued;          // Tasks sitting in any deque
+    atomic_int sleeping;        // Workers blocked on 'wake'
+    atomic_int stop;
+    pthread_mutex_t sleepLock;
+    pthread_cond_t wake;
+} pool;
+
+static _Thread_local int workerId = -1; // -1 outside the pool
+
+static int takeTask(Task *out) {
+    Deque *own = &pool.deques[workerId];
+    pthread_mutex_lock(&own->lock);
+    if (own->bottom != own->top) {
+        *out = own->tasks[--own->bottom % DEQUE_CAPACITY];
+        pthread_mutex_unlock(&own->lock);
+        atomic_fetch_sub(&pool.queued, 1);
+        return 1;
     }
+    pthread_mutex_unlock(&own->lock);
+    for (int v = 1; v < pool.threads; v++) {
+        Deque *victim = &pool.deques[(workerId + v) % pool.threads];
+        pthread_mutex_lock(&victim->lock);
+        if (victim->bottom != victim->top) {
+            *out = victim->tasks[victim->top++ % DEQUE_CAPACITY];
+            pthread_mutex_unlock(&victim->lock);
+            atomic_fetch_sub(&pool.queued, 1);
+            return 1;
+        }
+        pthread_mutex_unlock(&victim->lock);
+    }
+    return 0;
+}
+
+static void runTask(Task t) {
+    t.fn(t.arg);
+    atomic_fetch_sub(t.pending, 1);
+}
 
-    int k = n / 2;
-    int **A11 = allocateMatrix(k); int **A12 = allocateMatrix(k);
-    int **A21 = allocateMatrix(k); int **A22 = allocateMatrix(k);
-    int **B11 = allocateMatrix(k); int **B12 = allocateMatrix(k);
-    int **B21 = allocateMatrix(k); int **B22 = allocateMatrix(k);
+// Queues fn(arg) and counts it in *pending; runs it at once outside the pool
+static void spawn(void (*fn)(void *), void *arg, atomic_int *pending) {
+    Task t = {fn, arg, pending};
+    atomic_fetch_add(pending, 1);
+    if (workerId < 0) {
+        runTask(t);
+        return;
+    }
+    Deque *own = &pool.deques[workerId];
+    pthread_mutex_lock(&own->lock);
+    if (own->bottom - own->top == DEQUE_CAPACITY) {
+        pthread_mutex_unlock(&own->lock);
+        runTask(t);
+        return;
+    }
+    own->tasks[own->bottom++ % DEQUE_CAPACITY] = t;
+    pthread_mutex_unlock(&own->lock);
+    // A worker counts itself in 'sleeping' before re-checking 'queued' under
+    // sleepLock, so either it sees this task or we see it and signal
+    atomic_fetch_add(&pool.queued, 1);
+    if (atomic_load(&pool.sleeping) > 0) {
+        pthread_mutex_lock(&pool.sleepLock);
+        pthread_cond_signal(&pool.wake);
+        pthread_mutex_unlock(&pool.sleepLock);
+    }
+}
 
-    for (int i = 0; i < k; i++) {
-        for (int j = 0; j < k; j++) {
-            A11[i][j] = A[i][j];
-            A12[i][j] = A[i][j + k];
-            A21[i][j] = A[i + k][j];
-            A22[i][j] = A[i + k][j + k];
+// Runs queued tasks until everything counted in *pending has finished
+static void waitTasks(atomic_int *pending) {
+    Task t;
+    while (atomic_load(pending) > 0) {
+        if (workerId >= 0 && takeTask(&t)) runTask(t);
+        else sched_yield();
+    }
+}
 
-            B11[i][j] = B[i][j];
-            B12[i][j] = B[i][j + k];
-            B21[i][j] = B[i + k][j];
-            B22[i][j] = B[i + k][j + k];
+static void *workerMain(void *arg) {
+    workerId = (int)(intptr_t)arg;
+    Task t;
+    for (;;) {
+        if (takeTask(&t)) {
+            runTask(t);
+            continue;
         }
+        pthread_mutex_lock(&pool.sleepLock);
+        atomic_fetch_add(&pool.sleeping, 1);
+        while (atomic_load(&pool.queued) == 0 && !atomic_load(&pool.stop))
+            pthread_cond_wait(&pool.wake, &pool.sleepLock);
+        atomic_fetch_sub(&pool.sleeping, 1);
+        pthread_mutex_unlock(&pool.sleepLock);
+        if (atomic_load(&pool.stop)) break;
     }
+    gemmReleaseBuffers();
+    return NULL;
+}
 
-    int **M1 = allocateMatrix(k); int **M2 = allocateMatrix(k);
-    int **M3 = allocateMatrix(k); int **M4 = allocateMatrix(k);
-    int **M5 = allocateMatrix(k); int **M6 = allocateMatrix(k);
-    int **M7 = allocateMatrix(k);
-    int **temp1 = allocateMatrix(k); int **temp2 = allocateMatrix(k);
+static void poolStart(int threads) {
+    pool.threads = threads < 1 ? 1 : threads > MAX_WORKERS ? MAX_WORKERS : threads;
+    atomic_store(&pool.queued, 0);
+    atomic_store(&pool.sleeping, 0);
+    atomic_store(&pool.stop, 0);
+    pthread_mutex_init(&pool.sleepLock, NULL);
+    pthread_cond_init(&pool.wake, NULL);
+    for (int w = 0; w < pool.threads; w++) {
+        pthread_mutex_init(&pool.deques[w].lock, NULL);
+        pool.deques[w].top = pool.deques[w].bottom = 0;
+    }
+    workerId = 0;
+    for (int w = 1; w < pool.threads; w++)
+        pthread_create(&pool.ids[w], NULL, workerMain, (void *)(intptr_t)w);
+}
 
-    // M1 = (A11 + A22) * (B11 + B22)
-    addMatrix(A11, A22, temp1, k);
-    addMatrix(B11, B22, temp2, k);
-    strassen(temp1, temp2, M1, k);
+// Callers must have waited for all their tasks
+static void poolStop(void) {
+    pthread_mutex_lock(&pool.sleepLock);
+    atomic_store(&pool.stop, 1);
+    pthread_cond_broadcast(&pool.wake);
+    pthread_mutex_unlock(&pool.sleepLock);
+    for (int w = 1; w < pool.threads; w++)
+        pthread_join(pool.ids[w], NULL);
+    for (int w = 0; w < pool.threads; w++)
+        pthread_mutex_destroy(&pool.deques[w].lock);
+    pthread_mutex_destroy(&pool.sleepLock);
+    pthread_cond_destroy(&pool.wake);
+    workerId = -1;
+}
 
-    // M2 = (A21 + A22) * B11
-    addMatrix(A21, A22, temp1, k);
-    strassen(temp1, B11, M2, k);
+// --- Row-Parallel Loops ---
 
-    // M3 = A11 * (B12 - B22)
-    subMatrix(B12, B22, temp2, k);
-    strassen(A11, temp2, M3, k);
+#define PARALLEL_ROWS_MIN 512   // Smaller element-wise passes stay sequential
+#define ROWS_PER_BAND 64
 
-    // M4 = A22 * (B21 - B11)
-    subMatrix(B21, B11, temp2, k);
-    strassen(A22, temp2, M4, k);
+typedef void (*RowsFn)(void *ctx, int lo, int hi);
 
-    // M5 = (A11 + A12) * B22
-    addMatrix(A11, A12, temp1, k);
-    strassen(temp1, B22, M5, k);
+typedef struct {
+    RowsFn fn;
+    void *ctx;
+    int lo, hi;
+} RowBand;
 
-    // M6 = (A21 - A11) * (B11 + B12)
-    subMatrix(A21, A11, temp1, k);
-    addMatrix(B11, B12, temp2, k);
-    strassen(temp1, temp2, M6, k);
+static void runBand(void *arg) {
+    RowBand *band = (RowBand *)arg;
+    band->fn(band->ctx, band->lo, band->hi);
+}
 
-    // M7 = (A12 - A22) * (B21 + B22)
-    subMatrix(A12, A22, temp1, k);
-    addMatrix(B21, B22, temp2, k);
-    strassen(temp1, temp2, M7, k);
+// Runs fn over rows [0, rows), split into bands that run as pool tasks
+// when inside the pool and the pass is large enough to pay for them
+static void forRows(int rows, RowsFn fn, void *ctx) {
+    if (workerId < 0 || pool.threads == 1 || rows < PARALLEL_ROWS_MIN) {
+        fn(ctx, 0, rows);
+        return;
+    }
+    int bands = rows / ROWS_PER_BAND;
+    RowBand band[bands];
+    atomic_int pending = 0;
+    for (int b = 0; b < bands; b++) {
+        band[b] = (RowBand){fn, ctx, b * rows / bands, (b + 1) * rows / bands};
+        if (b > 0) spawn(runBand, &band[b], &pending);
+    }
+    runBand(&band[0]);
+    waitTasks(&pending);
+}
 
-    // Combine results into C
-    int **C11 = allocateMatrix(k); int **C12 = allocateMatrix(k);
-    int **C21 = allocateMatrix(k); int **C22 = allocateMatrix(k);
+typedef struct {
+    Matrix A, B, C;
+    int cols;
+} ElementwiseArgs;
 
-    for (int i = 0; i < k; i++)
-        for (int j = 0; j < k; j++) {
-            C11[i][j] = M1[i][j] + M4[i][j] - M5[i][j] + M7[i][j];
-            C12[i][j] = M3[i][j] + M5[i][j];
-            C21[i][j] = M2[i][j] + M4[i][j];
-            C22[i][j] = M1[i][j] - M2[i][j] + M3[i][j] + M6[i][j];
+static void addRows(void *ctx, int lo, int hi) {
+    ElementwiseArgs *e = (ElementwiseArgs *)ctx;
+    for (int i = lo; i < hi; i++)
+        for (int j = 0; j < e->cols; j++)
+            AT(e->C, i, j) = AT(e->A, i, j) + AT(e->B, i, j);
+}
+
+static void subRows(void *ctx, int lo, int hi) {
+    ElementwiseArgs *e = (ElementwiseArgs *)ctx;
+    for (int i = lo; i < hi; i++)
+        for (int j = 0; j < e->cols; j++)
+            AT(e->C, i, j) = AT(e->A, i, j) - AT(e->B, i, j);
+}
+
+// Bytes read and written by element-wise passes (sums and the combine
+// step) since the last reset; GEMM's own packing is not counted
+static atomic_llong bytesMoved;
+
+static void countBytes(size_t elements) {
+    atomic_fetch_add_explicit(&bytesMoved, (long long)(elements * sizeof(int)), memory_order_relaxed);
+}
+
+// Function to add two rows x cols matrices
+void addMatrix(Matrix A, Matrix B, Matrix C, int rows, int cols) {
+    ElementwiseArgs e = {A, B, C, cols};
+    countBytes(3 * (size_t)rows * cols);
+    forRows(rows, addRows, &e);
+}
+
+// Function to subtract two rows x cols matrices
+void subMatrix(Matrix A, Matrix B, Matrix C, int rows, int cols) {
+    ElementwiseArgs e = {A, B, C, cols};
+    countBytes(3 * (size_t)rows * cols);
+    forRows(rows, subRows, &e);
+}
+
+// --- Base Case ---
+
+// C = A * B for A m x k and B k x n, by the packed GEMM in gemm.h
+void baseMultiply(Matrix A, Matrix B, Matrix C, int m, int k, int n) {
+    gemmInt32(m, n, k, A.data, A.stride, B.data, B.stride, C.data, C.stride, 0);
+}
+
+// --- Strassen ---
+
+// Sizes where any dimension is at or below the cutoff use baseMultiply().
+// Build with -DSTRASSEN_CUTOFF=<n> to fix it; 0 means tune on the first
+// large multiply.
+#ifndef STRASSEN_CUTOFF
+#define STRASSEN_CUTOFF 0
+#endif
+#define DEFAULT_CUTOFF 64       // Used for multiplies too small to be worth tuning for
+#define MAX_TUNED_CUTOFF 512
+#define MAX_PARALLEL_LEVELS 2   // 49 tasks keep up to 32 threads busy
+
+static int strassenCutoff = STRASSEN_CUTOFF;
+static int strassenThreads = 1;
+
+void setStrassenCutoff(int cutoff) {
+    strassenCutoff = cutoff;
+}
+
+void setStrassenThreads(int threads) {
+    strassenThreads = threads;
+}
+
+static int cutoffInEffect(void) {
+    return strassenCutoff > 0 ? strassenCutoff : DEFAULT_CUTOFF;
+}
+
+static int belowCutoff(int m, int k, int n) {
+    int c = cutoffInEffect();
+    return m <= c || k <= c || n <= c;
+}
+
+// Strassen levels an m x k by k x n multiply recurses through before every
+// product is below the cutoff
+static int levelsBelow(int m, int k, int n) {
+    int levels = 0;
+    while (!belowCutoff(m >> levels, k >> levels, n >> levels)) levels++;
+    return levels;
+}
+
+// Top recursion levels whose 7 products run as tasks: enough for about two
+// tasks per thread (7 per level, 49 for two levels)
+static int parallelLevels(void) {
+    if (strassenThreads <= 1) return 0;
+    int levels = 1;
+    for (int tasks = 7; tasks < 2 * strassenThreads && levels < MAX_PARALLEL_LEVELS; tasks *= 7)
+        levels++;
+    return levels;
+}
+
+/**
+ * Ints of workspace for an m x k by k x n multiply whose top 'depth' levels
+ * run their products concurrently. Each level splits every dimension in
+ * half, less any rows or columns peeled off first (see strassenLevels). The
+ * quadrants of A, B and C are views, so a level only carves the 3 products
+ * that have no quadrant of C to live in, plus the operand sums. A
+ * sequential level's products run one after another and share one pair of
+ * sums and one child workspace; a parallel level gives each of its 7
+ * products its own slice of both.
+ */
+static size_t workspaceFor(int m, int k, int n, int depth) {
+    if (belowCutoff(m, k, n)) return 0;
+    size_t m2 = m / 2, k2 = k / 2, n2 = n / 2;
+    size_t perProduct = m2 * k2 + k2 * n2 + workspaceFor((int)m2, (int)k2, (int)n2, depth > 0 ? depth - 1 : 0);
+    return 3 * m2 * n2 + (depth > 0 ? 7 : 1) * perProduct;
+}
+
+// Ints of workspace strassenMultiply() needs for an m x k by k x n multiply
+size_t strassenWorkspace(int m, int k, int n) {
+    return workspaceFor(m, k, n, parallelLevels());
+}
+
+// Quadrant views of the even parts of A (m2 x k2 each) and B (k2 x n2 each)
+typedef struct {
+    Matrix A11, A12, A21, A22, B11, B12, B21, B22;
+    int m2, k2, n2;
+} Quadrants;
+
+/**
+ * M2, M3, M6 and M7 are computed straight into C21, C12, C22 and C11; M1,
+ * M4 and M5 into temporaries. One pass then finishes every quadrant:
+ *   C11 = M7 + M1 + M4 - M5      C12 = M3 + M5
+ *   C21 = M2 + M4                C22 = M6 + M1 - M2 + M3
+ * reading M2 and M3 from C21 and C12 before those are overwritten.
+ */
+typedef struct {
+    Matrix C11, C12, C21, C22, M1, M4, M5;
+    int n2;
+} Combine;
+
+static void combineRows(void *ctx, int lo, int hi) {
+    Combine *c = (Combine *)ctx;
+    for (int i = lo; i < hi; i++)
+        for (int j = 0; j < c->n2; j++) {
+            int m1 = AT(c->M1, i, j), m2 = AT(c->C21, i, j), m3 = AT(c->C12, i, j);
+            int m4 = AT(c->M4, i, j), m5 = AT(c->M5, i, j);
+            AT(c->C11, i, j) += m1 + m4 - m5;
+            AT(c->C22, i, j) += m1 - m2 + m3;
+            AT(c->C12, i, j) = m3 + m5;
+            AT(c->C21, i, j) = m2 + m4;
         }
+}
 
-    for (int i = 0; i < k; i++)
-        for (int j = 0; j < k; j++) {
-            C[i][j] = C11[i][j];
-            C[i][j + k] = C12[i][j];
-            C[i + k][j] = C21[i][j];
-            C[i + k][j + k] = C22[i][j];
+static void strassenLevels(Matrix A, Matrix B, Matrix C, int m, int k, int n, int *workspace, int depth);
+
+// Computes Strassen product 'which' (0..6 for M1..M7) into M, forming its
+// operand sums in tempA (m2 x k2) and tempB (k2 x n2)
+static void strassenProduct(const Quadrants *q, int which, Matrix M, Matrix tempA, Matrix tempB,
+                            int *workspace, int depth) {
+    int m2 = q->m2, k2 = q->k2, n2 = q->n2;
+    switch (which) {
+    case 0: // M1 = (A11 + A22) * (B11 + B22)
+        addMatrix(q->A11, q->A22, tempA, m2, k2);
+        addMatrix(q->B11, q->B22, tempB, k2, n2);
+        strassenLevels(tempA, tempB, M, m2, k2, n2, workspace, depth);
+        break;
+    case 1: // M2 = (A21 + A22) * B11
+        addMatrix(q->A21, q->A22, tempA, m2, k2);
+        strassenLevels(tempA, q->B11, M, m2, k2, n2, workspace, depth);
+        break;
+    case 2: // M3 = A11 * (B12 - B22)
+        subMatrix(q->B12, q->B22, tempB, k2, n2);
+        strassenLevels(q->A11, tempB, M, m2, k2, n2, workspace, depth);
+        break;
+    case 3: // M4 = A22 * (B21 - B11)
+        subMatrix(q->B21, q->B11, tempB, k2, n2);
+        strassenLevels(q->A22, tempB, M, m2, k2, n2, workspace, depth);
+        break;
+    case 4: // M5 = (A11 + A12) * B22
+        addMatrix(q->A11, q->A12, tempA, m2, k2);
+        strassenLevels(tempA, q->B22, M, m2, k2, n2, workspace, depth);
+        break;
+    case 5: // M6 = (A21 - A11) * (B11 + B12)
+        subMatrix(q->A21, q->A11, tempA, m2, k2);
+        addMatrix(q->B11, q->B12, tempB, k2, n2);
+        strassenLevels(tempA, tempB, M, m2, k2, n2, workspace, depth);
+        break;
+    default: // M7 = (A12 - A22) * (B21 + B22)
+        subMatrix(q->A12, q->A22, tempA, m2, k2);
+        addMatrix(q->B21, q->B22, tempB, k2, n2);
+        strassenLevels(tempA, tempB, M, m2, k2, n2, workspace, depth);
+        break;
+    }
+}
+
+typedef struct {
+    const Quadrants *q;
+    int which;
+    Matrix M, tempA, tempB;
+    int *workspace;
+    int depth;
+} ProductTask;
+
+static void runProduct(void *arg) {
+    ProductTask *t = (ProductTask *)arg;
+    strassenProduct(t->q, t->which, t->M, t->tempA, t->tempB, t->workspace, t->depth);
+}
+
+// --- Peeling Fix-ups ---
+
+// The GEMM pads m to MR and n to NR, so a single row or column of C would
+// cost it 6x or 16x the work. These loops do just the matrix-vector
+// product, in AVX2 where available (gcc -O2 leaves the plain loops scalar).
+
+#define FIXUP_CHUNK 256
+
+// Dot product of a[0..len) and b[0..len)
+static int dotInt32(const int *a, const int *b, int len) {
+    int x = 0, sum = 0;
+#ifdef __AVX2__
+    __m256i acc = _mm256_setzero_si256();
+    for (; x + 8 <= len; x += 8)
+        acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)(a + x)),
+                                                       _mm256_loadu_si256((const __m256i *)(b + x))));
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    sum = _mm_cvtsi128_si32(half);
+#endif
+    for (; x < len; x++) sum += a[x] * b[x];
+    return sum;
+}
+
+// C (m x 1) = A (m x k) * B (k x 1). The strided column of B is gathered
+// FIXUP_CHUNK entries at a time, so each row is a contiguous dot product.
+static void multiplyColumn(Matrix A, Matrix B, Matrix C, int m, int k) {
+    int b[FIXUP_CHUNK];
+    for (int i = 0; i < m; i++) AT(C, i, 0) = 0;
+    for (int x0 = 0; x0 < k; x0 += FIXUP_CHUNK) {
+        int len = k - x0 < FIXUP_CHUNK ? k - x0 : FIXUP_CHUNK;
+        for (int x = 0; x < len; x++) b[x] = AT(B, x0 + x, 0);
+        for (int i = 0; i < m; i++) AT(C, i, 0) += dotInt32(&AT(A, i, x0), b, len);
+    }
+}
+
+// C (1 x n) = A (1 x k) * B (k x n). Each block of columns keeps its sums
+// in registers while the rows of B stream past.
+static void multiplyRow(Matrix A, Matrix B, Matrix C, int k, int n) {
+    int j = 0;
+#ifdef __AVX2__
+    for (; j + 32 <= n; j += 32) {
+        __m256i c0 = _mm256_setzero_si256(), c1 = c0, c2 = c0, c3 = c0;
+        for (int x = 0; x < k; x++) {
+            __m256i a = _mm256_set1_epi32(AT(A, 0, x));
+            const int *b = &AT(B, x, j);
+            c0 = _mm256_add_epi32(c0, _mm256_mullo_epi32(a, _mm256_loadu_si256((const __m256i *)b)));
+            c1 = _mm256_add_epi32(c1, _mm256_mullo_epi32(a, _mm256_loadu_si256((const __m256i *)(b + 8))));
+            c2 = _mm256_add_epi32(c2, _mm256_mullo_epi32(a, _mm256_loadu_si256((const __m256i *)(b + 16))));
+            c3 = _mm256_add_epi32(c3, _mm256_mullo_epi32(a, _mm256_loadu_si256((const __m256i *)(b + 24))));
         }
+        _mm256_storeu_si256((__m256i *)&AT(C, 0, j), c0);
+        _mm256_storeu_si256((__m256i *)&AT(C, 0, j + 8), c1);
+        _mm256_storeu_si256((__m256i *)&AT(C, 0, j + 16), c2);
+        _mm256_storeu_si256((__m256i *)&AT(C, 0, j + 24), c3);
+    }
+    for (; j + 8 <= n; j += 8) {
+        __m256i c0 = _mm256_setzero_si256();
+        for (int x = 0; x < k; x++)
+            c0 = _mm256_add_epi32(c0, _mm256_mullo_epi32(_mm256_set1_epi32(AT(A, 0, x)),
+                                                         _mm256_loadu_si256((const __m256i *)&AT(B, x, j))));
+        _mm256_storeu_si256((__m256i *)&AT(C, 0, j), c0);
+    }
+#endif
+    for (; j < n; j++) {
+        int sum = 0;
+        for (int x = 0; x < k; x++) sum += AT(A, 0, x) * AT(B, x, j);
+        AT(C, 0, j) = sum;
+    }
+}
+
+/**
+ * Strassen for A m x k and B k x n, any sizes and strides, with the top
+ * 'depth' levels' products spawned as pool tasks. Quadrants are strided
+ * views into A, B and C, so the only data written besides C are the
+ * operand sums and three products per level. All of it comes from
+ * 'workspace', which must hold workspaceFor(m, k, n, depth) ints; nothing
+ * is allocated.
+ *
+ * Awkward sizes are handled by peeling rather than padding. With L levels
+ * to go (levelsBelow), each dimension is cut down to a multiple of 2^L, so
+ * the part that recurses halves evenly all the way down and no level
+ * below this one peels anything. The peeled strips, fewer than 2^L rows,
+ * columns or inner indices, are fixed up afterwards: a GEMM update for the
+ * inner strip and GEMM products for the last columns and rows of C, or
+ * multiplyColumn / multiplyRow when the strip is a single column or row
+ * (the GEMM would pad it to a full tile). Peeling once at the top instead
+ * of one index per level keeps the fix-ups to O((mk + kn + mn) 2^L) work
+ * at full GEMM speed; per-level fix-ups add up over the 7^d subproblems of
+ * each level.
+ */
+static void strassenLevels(Matrix A, Matrix B, Matrix C, int m, int k, int n, int *workspace, int depth) {
+    if (belowCutoff(m, k, n)) {
+        baseMultiply(A, B, C, m, k, n);
+        return;
+    }
+
+    int even = ~((1 << levelsBelow(m, k, n)) - 1);
+    int m2 = (m & even) / 2, k2 = (k & even) / 2, n2 = (n & even) / 2;
+    Quadrants q = {view(A, 0, 0, m2, k2), view(A, 0, k2, m2, k2),
+                   view(A, m2, 0, m2, k2), view(A, m2, k2, m2, k2),
+                   view(B, 0, 0, k2, n2), view(B, 0, n2, k2, n2),
+                   view(B, k2, 0, k2, n2), view(B, k2, n2, k2, n2), m2, k2, n2};
+    Combine combine = {view(C, 0, 0, m2, n2), view(C, 0, n2, m2, n2),
+                       view(C, m2, 0, m2, n2), view(C, m2, n2, m2, n2),
+                       carve(&workspace, m2, n2), carve(&workspace, m2, n2),
+                       carve(&workspace, m2, n2), n2};
+    Matrix M[7] = {combine.M1, combine.C21, combine.C12, combine.M4,
+                   combine.M5, combine.C22, combine.C11};
+
+    if (depth > 0) {
+        // Each product gets its own sums and child workspace slice
+        size_t childInts = workspaceFor(m2, k2, n2, depth - 1);
+        ProductTask tasks[7];
+        atomic_int pending = 0;
+        for (int p = 0; p < 7; p++) {
+            Matrix tempA = carve(&workspace, m2, k2), tempB = carve(&workspace, k2, n2);
+            tasks[p] = (ProductTask){&q, p, M[p], tempA, tempB, workspace, depth - 1};
+            workspace += childInts;
+            if (p > 0) spawn(runProduct, &tasks[p], &pending);
+        }
+        runProduct(&tasks[0]);
+        waitTasks(&pending);
+    } else {
+        // Products run in turn, so they share the sums and whatever
+        // follows them in the workspace
+        Matrix tempA = carve(&workspace, m2, k2), tempB = carve(&workspace, k2, n2);
+        for (int p = 0; p < 7; p++)
+            strassenProduct(&q, p, M[p], tempA, tempB, workspace, 0);
+    }
+
+    countBytes(11 * (size_t)m2 * n2);
+    forRows(m2, combineRows, &combine);
+
+    int me = 2 * m2, ke = 2 * k2, ne = 2 * n2;
+    // Leading part of C += last columns of A * last rows of B
+    if (ke < k)
+        gemmInt32(me, ne, k - ke, &AT(A, 0, ke), A.stride, &AT(B, ke, 0), B.stride, C.data, C.stride, 1);
+    // Last columns of C = A * last columns of B
+    if (ne + 1 == n)
+        multiplyColumn(A, view(B, 0, ne, k, 1), view(C, 0, ne, m, 1), m, k);
+    else if (ne < n)
+        gemmInt32(m, n - ne, k, A.data, A.stride, &AT(B, 0, ne), B.stride, &AT(C, 0, ne), C.stride, 0);
+    // Last rows of C (but their last columns) = last rows of A * B
+    if (me + 1 == m)
+        multiplyRow(view(A, me, 0, 1, k), B, view(C, me, 0, 1, ne), k, ne);
+    else if (me < m)
+        gemmInt32(m - me, ne, k, &AT(A, me, 0), A.stride, B.data, B.stride, &AT(C, me, 0), C.stride, 0);
+}
+
+// Sequential Strassen; 'workspace' must hold workspaceFor(m, k, n, 0) ints
+void strassen(Matrix A, Matrix B, Matrix C, int m, int k, int n, int *workspace) {
+    strassenLevels(A, B, C, m, k, n, workspace, 0);
+}
+
+static double nowSeconds(void);
+static void fillRandom(Matrix M, int rows, int cols);
+int tuneCutoff(void);
+
+// C = A * B for A m x k and B k x n (any sizes); sizes the workspace once
+// and, with more than one thread set, runs the top levels on a pool
+void strassenMultiply(Matrix A, Matrix B, Matrix C, int m, int k, int n) {
+    if (strassenCutoff == 0 && !(m <= DEFAULT_CUTOFF || k <= DEFAULT_CUTOFF || n <= DEFAULT_CUTOFF))
+        strassenCutoff = tuneCutoff();
+    int depth = parallelLevels();
+    size_t ints = workspaceFor(m, k, n, depth);
+    int *workspace = (int *)malloc((ints > 0 ? ints : 1) * sizeof(int));
+    if (workspace == NULL) {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
+    if (depth > 0) {
+        poolStart(strassenThreads);
+        strassenLevels(A, B, C, m, k, n, workspace, depth);
+        poolStop();
+    } else {
+        strassen(A, B, C, m, k, n, workspace);
+    }
+    free(workspace);
 }
 
 // Function to print a matrix
-void printMatrix(int **M, int n) {
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++)
-            printf("%4d ", M[i][j]);
+void printMatrix(Matrix M, int rows, int cols) {
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++)
+            printf("%4d ", AT(M, i, j));
         printf("\n");
     }
     printf("\n");
 }
 
-int main() {
-    int n;
-    printf("Enter size of square matrix (power of 2): ");
-    scanf("%d", &n);
+// --- Benchmark ---
+
+static unsigned long long rngState = 88172645463325252ULL;
+static int nextKey(void) {
+    rngState ^= rngState << 13; rngState ^= rngState >> 7; rngState ^= rngState << 17;
+    return (int)(rngState & 0x7fffffff);
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Peak resident set size of the process so far, in MB
+static double peakRssMB(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0; // ru_maxrss is in KB on Linux
+}
+
+static void fillRandom(Matrix M, int rows, int cols) {
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+            AT(M, i, j) = nextKey() % 19 - 9;
+}
+
+// Recomputes 'samples' random entries of C = A * B directly; returns 1 if all match
+int spotCheck(Matrix A, Matrix B, Matrix C, int m, int k, int n, int samples) {
+    for (int s = 0; s < samples; s++) {
+        int i = nextKey() % m, j = nextKey() % n;
+        int sum = 0;
+        for (int x = 0; x < k; x++)
+            sum += AT(A, i, x) * AT(B, x, j);
+        if (sum != AT(C, i, j)) return 0;
+    }
+    return 1;
+}
+
+// Best of 'reps' timings of C = A * B with the current cutoff
+static double timeMultiply(Matrix A, Matrix B, Matrix C, int n, int *workspace, int reps) {
+    double best = 1e30;
+    for (int r = 0; r < reps; r++) {
+        double start = nowSeconds();
+        strassen(A, B, C, n, n, n, workspace);
+        double elapsed = nowSeconds() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+/**
+ * Finds the crossover: for c = 32, 64, ... it times a 2c x 2c multiply done
+ * directly by baseMultiply() against one Strassen level over c x c
+ * GEMM products. The first c where Strassen wins becomes the cutoff (it
+ * no longer pays to go below c); if it never wins, the largest c tried.
+ * Takes well under a second; the result is kept for the process.
+ */
+int tuneCutoff(void) {
+    int chosen = MAX_TUNED_CUTOFF;
+    int saved = strassenCutoff;
+    for (int c = 32; c <= MAX_TUNED_CUTOFF; c *= 2) {
+        int n = 2 * c;
+        Matrix A = allocateMatrix(n, n), B = allocateMatrix(n, n), C = allocateMatrix(n, n);
+        fillRandom(A, n, n);
+        fillRandom(B, n, n);
+        strassenCutoff = c;
+        int *workspace = (int *)malloc((workspaceFor(n, n, n, 0) + 1) * sizeof(int));
+        if (workspace == NULL) {
+            printf("Memory allocation failed!\n");
+            exit(1);
+        }
+        double oneLevel = timeMultiply(A, B, C, n, workspace, 3);
+        strassenCutoff = n;
+        double direct = timeMultiply(A, B, C, n, workspace, 3);
+        free(workspace);
+        freeMatrix(&A);
+        freeMatrix(&B);
+        freeMatrix(&C);
+        if (oneLevel < direct) {
+            chosen = c;
+            break;
+        }
+    }
+    strassenCutoff = saved;
+    return chosen;
+}
+
+// GFLOP/s of an n x n multiply taking 'seconds' (2n^3 multiply-adds counted
+// as for the classical algorithm, so Strassen's savings show as a higher rate)
+static double gflops(int n, double seconds) {
+    return 2.0 * n * n * (double)n / seconds / 1e9;
+}
+
+// Sweeps cutoffs for each size and reports GFLOP/s (cutoff >= n is the
+// GEMM kernel alone)
+void runCutoffSweep(int maxN) {
+    static const int cutoffs[] = {16, 32, 64, 128, 256, 512, 1 << 30};
+    int numCutoffs = (int)(sizeof(cutoffs) / sizeof(cutoffs[0]));
+    int saved = strassenCutoff;
 
-    int **A = allocateMatrix(n);
-    int **B = allocateMatrix(n);
-    int **C = allocateMatrix(n);
+    printf("--- Hybrid Strassen: GFLOP/s by cutoff (tuned cutoff: %d) ---\n", tuneCutoff());
+    printf("%8s", "n");
+    for (int c = 0; c < numCutoffs - 1; c++) printf("   cut=%-4d", cutoffs[c]);
+    printf("%11s\n", "gemm");
+
+    for (int n = 256; n <= maxN; n *= 2) {
+        Matrix A = allocateMatrix(n, n), B = allocateMatrix(n, n), C = allocateMatrix(n, n);
+        fillRandom(A, n, n);
+        fillRandom(B, n, n);
+        printf("%8d", n);
+        for (int c = 0; c < numCutoffs; c++) {
+            strassenCutoff = cutoffs[c];
+            int *workspace = (int *)malloc((workspaceFor(n, n, n, 0) + 1) * sizeof(int));
+            if (workspace == NULL) {
+                printf("Memory allocation failed!\n");
+                exit(1);
+            }
+            double t = timeMultiply(A, B, C, n, workspace, 1);
+            printf("%11.2f", gflops(n, t));
+            fflush(stdout);
+            free(workspace);
+        }
+        printf("\n");
+        freeMatrix(&A);
+        freeMatrix(&B);
+        freeMatrix(&C);
+    }
+    strassenCutoff = saved;
+}
+
+// Best-of-3 GFLOP/s of gemm<Suffix> on n x n matrices of T; checks one
+// row against a direct dot product first
+#define GEMM_RATE(Suffix, T, n, result)                                               \
+    do {                                                                              \
+        T *a = (T *)malloc((size_t)(n) * (n) * sizeof(T));                            \
+        T *b = (T *)malloc((size_t)(n) * (n) * sizeof(T));                            \
+        T *c = (T *)malloc((size_t)(n) * (n) * sizeof(T));                            \
+        if (a == NULL || b == NULL || c == NULL) {                                    \
+            printf("Memory allocation failed!\n");                                    \
+            exit(1);                                                                  \
+        }                                                                             \
+        for (size_t x = 0; x < (size_t)(n) * (n); x++) {                              \
+            a[x] = (T)(nextKey() % 19 - 9);                                           \
+            b[x] = (T)(nextKey() % 19 - 9);                                           \
+        }                                                                             \
+        double best = 1e30;                                                           \
+        for (int r = 0; r < 3; r++) {                                                 \
+            double start = nowSeconds();                                              \
+            gemm##Suffix(n, n, n, a, n, b, n, c, n, 0);                               \
+            double elapsed = nowSeconds() - start;                                    \
+            if (elapsed < best) best = elapsed;                                       \
+        }                                                                             \
+        int row = nextKey() % (n);                                                    \
+        for (int j = 0; j < (n); j++) {                                               \
+            T sum = 0;                                                                \
+            for (int x = 0; x < (n); x++) sum += a[(size_t)row * (n) + x] * b[(size_t)x * (n) + j]; \
+            if (sum != c[(size_t)row * (n) + j]) gemmMismatch = 1;                    \
+        }                                                                             \
+        (result) = gflops(n, best);                                                   \
+        free(a);                                                                      \
+        free(b);                                                                      \
+        free(c);                                                                      \
+    } while (0)
+
+// GFLOP/s of the micro-kernel alone, on packed slivers that stay in L1:
+// the ceiling the full GEMM can approach. One untimed pass warms the
+// caches and the clock, then the best of 5 passes is kept
+#define KERNEL_RATE(Suffix, T, NR, result)                                            \
+    do {                                                                              \
+        _Alignas(64) static T a[GEMM_KC * GEMM_MR], b[GEMM_KC * (NR)], c[GEMM_MR * (NR)]; \
+        for (int x = 0; x < GEMM_KC * GEMM_MR; x++) a[x] = (T)(x % 3);                \
+        for (int x = 0; x < GEMM_KC * (NR); x++) b[x] = (T)(x % 5);                   \
+        int calls = 20000;                                                            \
+        double best = 1e30;                                                           \
+        for (int pass = 0; pass <= 5; pass++) {                                       \
+            double start = nowSeconds();                                              \
+            for (int r = 0; r < calls; r++) microKernel##Suffix(GEMM_KC, a, b, c, NR, r & 1); \
+            double elapsed = nowSeconds() - start;                                    \
+            if (pass > 0 && elapsed < best) best = elapsed;                           \
+        }                                                                             \
+        (result) = 2.0 * GEMM_MR * (NR) * GEMM_KC * calls / best / 1e9;               \
+    } while (0)
+
+// Flops per cycle of one core: two FMA ports x 8 float / 4 double lanes x
+// 2 flops. int32 has no fused multiply-add and vpmulld issues once per
+// cycle, so 8 lanes x (multiply + add). The scalar kernel manages about
+// one multiply-add per cycle.
+#if defined(__AVX2__) && defined(__FMA__)
+#define PEAK_FLOPS_INT32 16
+#define PEAK_FLOPS_FLOAT 32
+#define PEAK_FLOPS_DOUBLE 16
+#else
+#define PEAK_FLOPS_INT32 2
+#define PEAK_FLOPS_FLOAT 2
+#define PEAK_FLOPS_DOUBLE 2
+#endif
+
+/**
+ * Core clock in GHz, measured by timing a chain of dependent register
+ * adds (one cycle each; add-immediate is avoided because newer cores can
+ * fold it away at rename), so it reflects the turbo clock the kernels
+ * actually run at. Returns 0 where the chain cannot be written (non-x86).
+ */
+static double measureClockGHz(void) {
+#if defined(__x86_64__)
+    const long iterations = 50000000;
+    double best = 1e30;
+    for (int pass = 0; pass <= 5; pass++) {
+        unsigned long x = 0, step = 1;
+        double start = nowSeconds();
+        for (long r = 0; r < iterations; r++)
+            __asm__ volatile("add %1, %0\n\tadd %1, %0\n\tadd %1, %0\n\tadd %1, %0\n\t"
+                             "add %1, %0\n\tadd %1, %0\n\tadd %1, %0\n\tadd %1, %0"
+                             : "+r"(x) : "r"(step));
+        double elapsed = nowSeconds() - start;
+        if (pass > 0 && elapsed < best) best = elapsed;
+    }
+    return 8.0 * iterations / best / 1e9;
+#else
+    return 0;
+#endif
+}
+
+static int gemmMismatch = 0;
+
+/**
+ * GFLOP/s of the GEMM engine for int32, float and double at n = 128 ... maxN,
+ * as a percentage of the core's theoretical peak (PEAK_FLOPS_* x measured
+ * clock). The micro-kernel's in-cache rate is shown alongside as the
+ * practical ceiling. Without a clock measurement the percentages are taken
+ * against that kernel rate instead.
+ */
+void runGemmBenchmark(int maxN) {
+    double kernelI, kernelF, kernelD;
+    KERNEL_RATE(Int32, int32_t, GEMM_NR_INT32, kernelI);
+    KERNEL_RATE(Float, float, GEMM_NR_FLOAT, kernelF);
+    KERNEL_RATE(Double, double, GEMM_NR_DOUBLE, kernelD);
+
+    double ghz = measureClockGHz();
+    double peakI = ghz * PEAK_FLOPS_INT32, peakF = ghz * PEAK_FLOPS_FLOAT, peakD = ghz * PEAK_FLOPS_DOUBLE;
+    if (ghz > 0) {
+        printf("--- Packed GEMM: GFLOP/s (%% of theoretical peak at %.2f GHz) ---\n", ghz);
+    } else {
+        printf("--- Packed GEMM: GFLOP/s (%% of in-cache micro-kernel rate) ---\n");
+        peakI = kernelI;
+        peakF = kernelF;
+        peakD = kernelD;
+    }
+    printf("%8s %18s %18s %18s\n", "n", "int32", "float", "double");
+    if (ghz > 0) printf("%8s %18.2f %18.2f %18.2f\n", "peak", peakI, peakF, peakD);
+    printf("%8s %10.2f (%3.0f%%) %10.2f (%3.0f%%) %10.2f (%3.0f%%)\n", "kernel",
+           kernelI, 100 * kernelI / peakI, kernelF, 100 * kernelF / peakF, kernelD, 100 * kernelD / peakD);
+    for (int n = 128; n <= maxN; n *= 2) {
+        double ri, rf, rd;
+        GEMM_RATE(Int32, int32_t, n, ri);
+        GEMM_RATE(Float, float, n, rf);
+        GEMM_RATE(Double, double, n, rd);
+        printf("%8d %10.2f (%3.0f%%) %10.2f (%3.0f%%) %10.2f (%3.0f%%)\n", n,
+               ri, 100 * ri / peakI, rf, 100 * rf / peakF, rd, 100 * rd / peakD);
+    }
+    if (gemmMismatch) printf("GEMM result differs from direct product!\n");
+}
+
+/**
+ * Bytes moved outside GEMM per multiply: every sum and combine pass counts
+ * its reads and writes. Reported in MB and per element of C, with the
+ * workspace, for n = 256 ... maxN.
+ */
+void runTrafficBenchmark(int maxN) {
+    if (strassenCutoff == 0) strassenCutoff = tuneCutoff();
+    printf("--- Strassen data movement outside GEMM (cutoff %d) ---\n", strassenCutoff);
+    printf("%8s %12s %16s %16s %14s\n", "n", "time (s)", "workspace (MB)", "moved (MB)", "bytes / elem");
+    for (int n = 256; n <= maxN; n *= 2) {
+        Matrix A = allocateMatrix(n, n), B = allocateMatrix(n, n), C = allocateMatrix(n, n);
+        fillRandom(A, n, n);
+        fillRandom(B, n, n);
+        atomic_store(&bytesMoved, 0);
+        double start = nowSeconds();
+        strassenMultiply(A, B, C, n, n, n);
+        double elapsed = nowSeconds() - start;
+        double moved = (double)atomic_load(&bytesMoved);
+        printf("%8d %12.3f %16.1f %16.1f %14.1f\n", n, elapsed,
+               strassenWorkspace(n, n, n) * sizeof(int) / 1048576.0, moved / 1048576.0, moved / ((double)n * n));
+        freeMatrix(&A);
+        freeMatrix(&B);
+        freeMatrix(&C);
+    }
+}
+
+/**
+ * Multiplies random m x k by k x n matrices of arbitrary shape (each
+ * dimension 1..maxDim, with odd, prime and skinny sizes all likely) with a
+ * small cutoff, so the recursion runs several levels deep below strips of
+ * many widths, and compares every entry with a naive triple loop. Every
+ * fourth trial runs on 4 threads. Returns the number of mismatching shapes.
+ */
+int runVerify(int trials, int maxDim) {
+    int savedCutoff = strassenCutoff, failures = 0;
+    setStrassenCutoff(8);
+    printf("--- Strassen vs naive reference, %d random shapes up to %d ---\n", trials, maxDim);
+    for (int t = 0; t < trials; t++) {
+        int m = 1 + nextKey() % maxDim, k = 1 + nextKey() % maxDim, n = 1 + nextKey() % maxDim;
+        Matrix A = allocateMatrix(m, k), B = allocateMatrix(k, n), C = allocateMatrix(m, n);
+        fillRandom(A, m, k);
+        fillRandom(B, k, n);
+        setStrassenThreads(t % 4 == 3 ? 4 : 1);
+        strassenMultiply(A, B, C, m, k, n);
+
+        int ok = 1;
+        for (int i = 0; i < m && ok; i++)
+            for (int j = 0; j < n; j++) {
+                int sum = 0;
+                for (int x = 0; x < k; x++)
+                    sum += AT(A, i, x) * AT(B, x, j);
+                if (sum != AT(C, i, j)) {
+                    ok = 0;
+                    break;
+                }
+            }
+        if (!ok) {
+            printf("  MISMATCH for %d x %d by %d x %d\n", m, k, k, n);
+            failures++;
+        }
+        freeMatrix(&A);
+        freeMatrix(&B);
+        freeMatrix(&C);
+    }
+    setStrassenThreads(1);
+    setStrassenCutoff(savedCutoff);
+    printf("%d of %d shapes correct\n", trials - failures, trials);
+    return failures;
+}
+
+/**
+ * Multiplies the same random n x n matrices with 1, 2, 4, ... maxThreads
+ * threads and reports time, speedup over one thread and the workspace,
+ * which grows with the number of levels run in parallel.
+ */
+void runThreadBenchmark(int n, int maxThreads) {
+    if (strassenCutoff == 0) strassenCutoff = tuneCutoff();
+    Matrix A = allocateMatrix(n, n), B = allocateMatrix(n, n), C = allocateMatrix(n, n);
+    fillRandom(A, n, n);
+    fillRandom(B, n, n);
+
+    printf("--- Parallel Strassen, n = %d (cutoff %d) ---\n", n, strassenCutoff);
+    printf("%8s %8s %12s %10s %10s %16s %8s\n", "threads", "levels", "time (s)", "GFLOP/s", "speedup",
+           "workspace (MB)", "correct");
+    double base = 0;
+    for (int threads = 1;; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+        setStrassenThreads(threads);
+        double start = nowSeconds();
+        strassenMultiply(A, B, C, n, n, n);
+        double elapsed = nowSeconds() - start;
+        if (threads == 1) base = elapsed;
+        printf("%8d %8d %12.3f %10.2f %10.2f %16.1f %8s\n", threads, parallelLevels(), elapsed,
+               gflops(n, elapsed), base / elapsed, strassenWorkspace(n, n, n) * sizeof(int) / 1048576.0,
+               spotCheck(A, B, C, n, n, n, 64) ? "yes" : "NO");
+        if (threads >= maxThreads) break;
+    }
+    setStrassenThreads(1);
+    freeMatrix(&A);
+    freeMatrix(&B);
+    freeMatrix(&C);
+}
+
+/**
+ * Multiplies random n x n matrices for n = 64, 128, ... maxN and reports
+ * runtime, the workspace size and the process's peak RSS after each size
+ * (sizes grow, so each peak belongs to the largest multiply so far).
+ */
+void runBenchmark(int maxN) {
+    if (strassenCutoff == 0) strassenCutoff = tuneCutoff();
+    printf("--- Strassen with one preallocated workspace (cutoff %d) ---\n", strassenCutoff);
+    printf("%8s %12s %10s %16s %16s %8s\n", "n", "time (s)", "GFLOP/s", "workspace (MB)", "peak RSS (MB)", "correct");
+    for (int n = 64; n <= maxN; n *= 2) {
+        Matrix A = allocateMatrix(n, n), B = allocateMatrix(n, n), C = allocateMatrix(n, n);
+        fillRandom(A, n, n);
+        fillRandom(B, n, n);
+
+        double start = nowSeconds();
+        strassenMultiply(A, B, C, n, n, n);
+        double elapsed = nowSeconds() - start;
+
+        printf("%8d %12.3f %10.2f %16.1f %16.1f %8s\n", n, elapsed, gflops(n, elapsed),
+               strassenWorkspace(n, n, n) * sizeof(int) / 1048576.0, peakRssMB(),
+               spotCheck(A, B, C, n, n, n, 64) ? "yes" : "NO");
+        freeMatrix(&A);
+        freeMatrix(&B);
+        freeMatrix(&C);
+    }
+}
+
+// Build:  gcc -O2 -march=native matrix.c -o matrix -pthread  (add -DSTRASSEN_CUTOFF=<n> to skip tuning)
+// Usage: ./matrix              (interactive)
+//        ./matrix bench [max n] [cutoff]
+//        ./matrix bench-cutoff [max n]
+//        ./matrix bench-gemm [max n]
+//        ./matrix bench-threads [n] [max threads]
+//        ./matrix bench-traffic [max n]
+//        ./matrix verify [trials] [max dimension]
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        if (argc > 3) setStrassenCutoff(atoi(argv[3]));
+        runBenchmark(argc > 2 ? atoi(argv[2]) : 4096);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "bench-cutoff") == 0) {
+        runCutoffSweep(argc > 2 ? atoi(argv[2]) : 2048);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "bench-gemm") == 0) {
+        runGemmBenchmark(argc > 2 ? atoi(argv[2]) : 2048);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "bench-threads") == 0) {
+        runThreadBenchmark(argc > 2 ? atoi(argv[2]) : 2048, argc > 3 ? atoi(argv[3]) : 32);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "bench-traffic") == 0) {
+        runTrafficBenchmark(argc > 2 ? atoi(argv[2]) : 4096);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "verify") == 0)
+        return runVerify(argc > 2 ? atoi(argv[2]) : 200, argc > 3 ? atoi(argv[3]) : 300) > 0;
+
+    int m, k, n;
+    printf("Enter dimensions m k n (A is m x k, B is k x n): ");
+    if (scanf("%d %d %d", &m, &k, &n) != 3 || m < 1 || k < 1 || n < 1) return 1;
+
+    Matrix A = allocateMatrix(m, k);
+    Matrix B = allocateMatrix(k, n);
+    Matrix C = allocateMatrix(m, n);
 
     printf("Enter elements of Matrix A:\n");
-    for (int i = 0; i < n; i++)
-        for (int j = 0; j < n; j++)
-            scanf("%d", &A[i][j]);
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < k; j++)
+            scanf("%d", &AT(A, i, j));
 
     printf("Enter elements of Matrix B:\n");
-    for (int i = 0; i < n; i++)
+    for (int i = 0; i < k; i++)
         for (int j = 0; j < n; j++)
-            scanf("%d", &B[i][j]);
+            scanf("%d", &AT(B, i, j));
 
-    strassen(A, B, C, n);
+    strassenMultiply(A, B, C, m, k, n);
 
     printf("\nResultant Matrix (A × B):\n");
-    printMatrix(C, n);
+    printMatrix(C, m, n);
 
+    freeMatrix(&A);
+    freeMatrix(&B);
+    freeMatrix(&C);
     return 0;
 }
@@ -1,5 +1,10 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "simd_merge.h"
 
 // Structure for a singly linked list node
 struct Node {
@@ -41,80 +46,585 @@ void deleteList(struct Node* head) {
     }
 }
 
+// --- Node Arena ---
+
+#define ARENA_CHUNK_NODES 65536 // Nodes per chunk (1 MB with 16-byte nodes)
+
+// Block of nodes handed out in address order
+struct ArenaChunk {
+    struct ArenaChunk* next;  // Next chunk in allocation order
+    size_t used;
+    struct Node nodes[];
+};
+
+// Allocates nodes for one list from large chunks. Nodes are never freed
+// individually; arenaRelease() frees the whole list in one call.
+struct NodeArena {
+    struct ArenaChunk* first;
+    struct ArenaChunk* last;
+    size_t count;             // Nodes handed out
+};
+
+void arenaInit(struct NodeArena* arena) {
+    arena->first = arena->last = NULL;
+    arena->count = 0;
+}
+
+// Arena counterpart of newNode()
+struct Node* arenaNode(struct NodeArena* arena, int data) {
+    struct ArenaChunk* chunk = arena->last;
+    if (chunk == NULL || chunk->used == ARENA_CHUNK_NODES) {
+        chunk = (struct ArenaChunk*)malloc(sizeof(struct ArenaChunk) + ARENA_CHUNK_NODES * sizeof(struct Node));
+        if (chunk == NULL) {
+            printf("Memory allocation failed!\n");
+            exit(1);
+        }
+        chunk->next = NULL;
+        chunk->used = 0;
+        if (arena->last) arena->last->next = chunk;
+        else arena->first = chunk;
+        arena->last = chunk;
+    }
+    struct Node* node = &chunk->nodes[chunk->used++];
+    node->data = data;
+    node->next = NULL;
+    arena->count++;
+    return node;
+}
+
+// Frees every node of the arena: one free() per chunk instead of per node
+void arenaRelease(struct NodeArena* arena) {
+    struct ArenaChunk* chunk = arena->first;
+    while (chunk != NULL) {
+        struct ArenaChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    arenaInit(arena);
+}
+
+/**
+ * Relinks a list that owns every node of 'arena' so that list order is
+ * allocation (address) order: keys are copied out in list order, written
+ * back into the nodes chunk by chunk, and the nodes are chained in place.
+ * After a sort this turns each traversal into a sequential scan. Returns
+ * the new head, or 'head' unchanged if the list does not cover the arena.
+ */
+struct Node* arenaCompact(struct NodeArena* arena, struct Node* head) {
+    size_t n = arena->count;
+    if (n == 0) return head;
+    int* keys = (int*)malloc(n * sizeof(int));
+    if (keys == NULL) {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
+    // One walk in list order, the only random-access pass
+    size_t k = 0;
+    struct Node* node = head;
+    for (; node != NULL && k < n; node = node->next) keys[k++] = node->data;
+    if (node != NULL || k != n) {
+        free(keys);
+        return head;
+    }
+
+    struct Node dummy;
+    struct Node* tail = &dummy;
+    k = 0;
+    for (struct ArenaChunk* chunk = arena->first; chunk != NULL; chunk = chunk->next) {
+        for (size_t i = 0; i < chunk->used; i++) {
+            chunk->nodes[i].data = keys[k++];
+            tail->next = &chunk->nodes[i];
+            tail = tail->next;
+        }
+    }
+    tail->next = NULL;
+    free(keys);
+    return dummy.next;
+}
+
 // --- Merge Sort Core Functions ---
 
-// 1. Merges two sorted lists into one sorted list (Recursive)
+#define MAX_BINS 64 // bins[i] holds a run of 2^i nodes, so 64 bins cover any list
+
+// 1. Merges two sorted lists into one sorted list (Iterative, constant stack)
+// Ties take from 'a' first, so the sort is stable when 'a' holds earlier nodes.
 struct Node* SortedMerge(struct Node* a, struct Node* b) {
-    // Base cases
-    if (a == NULL) return b;
-    if (b == NULL) return a;
+    struct Node dummy;
+    struct Node* tail = &dummy;
 
-    struct Node* result = NULL;
+    while (a != NULL && b != NULL) {
+        if (a->data <= b->data) {
+            tail->next = a;
+            a = a->next;
+        } else {
+            tail->next = b;
+            b = b->next;
+        }
+        tail = tail->next;
+    }
+    // Splice whatever is left in one step
+    tail->next = (a != NULL) ? a : b;
+    return dummy.next;
+}
+
+// 2. Bottom-up merge sort: no recursion and no split traversals
+// Nodes are detached one at a time and carried up through the bins like a
+// binary counter: a run that finds bins[i] occupied merges with it and moves
+// on to bin i + 1. Each node is merged O(log n) times and the list is only
+// walked once from the front.
+void MergeSort(struct Node** headRef) {
+    struct Node* bins[MAX_BINS] = {NULL};
+    int maxBin = 0;
+    struct Node* node = *headRef;
 
-    // Pick either a or b, and recurse
-    if (a->data <= b->data) {
-        result = a;
-        result->next = SortedMerge(a->next, b);
-    } else {
-        result = b;
-        result->next = SortedMerge(a, b->next);
+    while (node != NULL) {
+        struct Node* next = node->next;
+        struct Node* run = node;
+        run->next = NULL;
+
+        int i = 0;
+        // Bins hold earlier nodes than 'run', so they go first to stay stable
+        while (i < MAX_BINS - 1 && bins[i] != NULL) {
+            run = SortedMerge(bins[i], run);
+            bins[i] = NULL;
+            i++;
+        }
+        if (bins[i] != NULL) run = SortedMerge(bins[i], run); // Only reachable past 2^63 nodes
+        bins[i] = run;
+        if (i > maxBin) maxBin = i;
+        node = next;
     }
-    return result;
+
+    // Fold the partial bins, lowest (latest nodes) first
+    struct Node* result = NULL;
+    for (int i = 0; i <= maxBin; i++)
+        result = SortedMerge(bins[i], result);
+    *headRef = result;
 }
 
-// 2. Splits the list into two halves (front and back) using fast/slow pointers
-void FrontBackSplit(struct Node* source, struct Node** frontRef, struct Node** backRef) {
-    struct Node* fast;
-    struct Node* slow;
+// --- Natural Merge Sort ---
+
+#define MAX_RUNS 96 // Stack invariants make run lengths grow like Fibonacci numbers
+#define MIN_RUN 16  // Shorter natural runs are extended by insertion
+
+// Detaches the maximal run at the front of *rest and returns it ascending.
+// A strictly descending run is reversed while it is walked (strictness keeps
+// equal keys in their original order).
+static struct Node* takeRun(struct Node** rest, size_t* length) {
+    struct Node* head = *rest;
+    size_t n = 1;
+
+    if (head->next != NULL && head->next->data < head->data) {
+        struct Node* reversed = head;
+        struct Node* node = head->next;
+        reversed->next = NULL;
+        while (node != NULL && node->data < reversed->data) {
+            struct Node* next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+            n++;
+        }
+        *rest = node;
+        *length = n;
+        return reversed;
+    }
+
+    struct Node* node = head;
+    while (node->next != NULL && node->data <= node->next->data) {
+        node = node->next;
+        n++;
+    }
+    *rest = node->next;
+    node->next = NULL;
+    *length = n;
+    return head;
+}
 
-    // Handle the case of 0 or 1 node
-    if (source == NULL || source->next == NULL) {
-        *frontRef = source;
-        *backRef = NULL;
-        return;
+// Merges stack entries i and i + 1 (i holds the earlier nodes)
+static void mergeRunsAt(struct Node** runs, size_t* lengths, int* top, int i) {
+    runs[i] = SortedMerge(runs[i], runs[i + 1]);
+    lengths[i] += lengths[i + 1];
+    for (int j = i + 1; j < *top - 1; j++) {
+        runs[j] = runs[j + 1];
+        lengths[j] = lengths[j + 1];
     }
+    (*top)--;
+}
+
+// Adaptive merge sort: splits the list into its existing runs (at least
+// MIN_RUN long) and merges them with TimSort's stack policy, including the
+// corrected invariant check, so similar-sized runs meet and sorted input
+// costs a single O(n) pass.
+void NaturalMergeSort(struct Node** headRef) {
+    struct Node* runs[MAX_RUNS];
+    size_t lengths[MAX_RUNS];
+    int top = 0;
+    struct Node* rest = *headRef;
 
-    slow = source;
-    fast = source->next; 
+    while (rest != NULL) {
+        runs[top] = takeRun(&rest, &lengths[top]);
 
-    // Advance fast two nodes, slow one node
-    while (fast != NULL) {
-        fast = fast->next;
-        if (fast != NULL) {
-            slow = slow->next;
-            fast = fast->next;
+        // Random data has runs of about two nodes; growing them by linear
+        // insertion is cheaper than merging that many tiny runs
+        while (lengths[top] < MIN_RUN && rest != NULL) {
+            struct Node* node = rest;
+            rest = rest->next;
+            struct Node** link = &runs[top];
+            while (*link != NULL && (*link)->data <= node->data) link = &(*link)->next;
+            node->next = *link;
+            *link = node;
+            lengths[top]++;
+        }
+        top++;
+
+        // Restore len[i-2] > len[i-1] + len[i] and len[i-1] > len[i]
+        while (top > 1) {
+            int n = top - 2;
+            if ((n > 0 && lengths[n - 1] <= lengths[n] + lengths[n + 1]) ||
+                (n > 1 && lengths[n - 2] <= lengths[n - 1] + lengths[n])) {
+                if (lengths[n - 1] < lengths[n + 1]) n--;
+            } else if (lengths[n] > lengths[n + 1]) {
+                break;
+            }
+            mergeRunsAt(runs, lengths, &top, n);
         }
     }
-    // 'slow' is at the end of the front list
-    *frontRef = source;
-    *backRef = slow->next;
-    slow->next = NULL; // Terminate the first half
+
+    while (top > 1)
+        mergeRunsAt(runs, lengths, &top, top - 2);
+    *headRef = top ? runs[0] : NULL;
 }
 
-// 3. Main recursive function to sort the list (Divide, Conquer, and Combine)
-void MergeSort(struct Node** headRef) {
-    struct Node* head = *headRef;
-    struct Node* a; // Front half
-    struct Node* b; // Back half
+// --- Benchmark ---
+
+static unsigned long long rngState = 88172645463325252ULL;
+static int nextKey(void) {
+    rngState ^= rngState << 13; rngState ^= rngState >> 7; rngState ^= rngState << 17;
+    return (int)(rngState & 0x7fffffff);
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Builds a list holding keys[0..n-1] in order
+struct Node* buildList(const int* keys, int n) {
+    struct Node dummy;
+    struct Node* tail = &dummy;
+    for (int i = 0; i < n; i++) {
+        tail->next = newNode(keys[i]);
+        tail = tail->next;
+    }
+    tail->next = NULL;
+    return dummy.next;
+}
+
+// Builds a list of n random keys
+struct Node* buildRandomList(int n) {
+    struct Node dummy;
+    struct Node* tail = &dummy;
+    for (int i = 0; i < n; i++) {
+        tail->next = newNode(nextKey());
+        tail = tail->next;
+    }
+    tail->next = NULL;
+    return dummy.next;
+}
+
+// Returns 1 if the list holds exactly n nodes in non-decreasing order
+int isSorted(struct Node* node, int n) {
+    int count = 0;
+    for (; node != NULL; node = node->next, count++)
+        if (node->next != NULL && node->next->data < node->data) return 0;
+    return count == n;
+}
+
+void runBenchmark(int maxNodes) {
+    printf("--- Bottom-up list merge sort ---\n");
+    printf("%12s %12s %12s %8s\n", "nodes", "sort (ms)", "ns/node", "sorted");
+    for (int n = 1000; n <= maxNodes; n *= 10) {
+        struct Node* head = buildRandomList(n);
+        double start = nowSeconds();
+        MergeSort(&head);
+        double elapsed = nowSeconds() - start;
+        printf("%12d %12.2f %12.1f %8s\n", n, elapsed * 1e3, elapsed / n * 1e9,
+               isSorted(head, n) ? "yes" : "NO");
+        deleteList(head);
+    }
+}
+
+// Relinks nodes[0..n-1] in order with keys[0..n-1], so repeated runs sort
+// the same input in the same memory layout
+static struct Node* relink(struct Node** nodes, const int* keys, int n) {
+    for (int i = 0; i < n; i++) {
+        nodes[i]->data = keys[i];
+        nodes[i]->next = i + 1 < n ? nodes[i + 1] : NULL;
+    }
+    return nodes[0];
+}
+
+// Sorts one input shape with both list sorts
+static void compareSorts(const char* shape, struct Node** nodes, const int* keys, int n) {
+    struct Node* head = relink(nodes, keys, n);
+    double start = nowSeconds();
+    MergeSort(&head);
+    double bottomUp = nowSeconds() - start;
+    int ok = isSorted(head, n);
+
+    head = relink(nodes, keys, n);
+    start = nowSeconds();
+    NaturalMergeSort(&head);
+    double natural = nowSeconds() - start;
+    ok = ok && isSorted(head, n);
+
+    printf("%-22s %14.2f %14.2f %8.2fx %8s\n", shape, bottomUp * 1e3, natural * 1e3,
+           bottomUp / natural, ok ? "yes" : "NO");
+}
+
+void runNaturalBenchmark(int n) {
+    int* keys = (int*)calloc((size_t)n, sizeof(int));
+    struct Node** nodes = (struct Node**)malloc((size_t)n * sizeof(struct Node*));
+    if (keys == NULL || nodes == NULL) {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
+    for (int i = 0; i < n; i++) nodes[i] = newNode(0);
+    printf("--- Bottom-up vs natural merge sort (%d nodes) ---\n", n);
+    printf("%-22s %14s %14s %9s %8s\n", "input", "bottom-up (ms)", "natural (ms)", "speedup", "sorted");
+
+    for (int i = 0; i < n; i++) keys[i] = i;
+    compareSorts("sorted", nodes, keys, n);
+
+    for (int i = 0; i < n; i++) keys[i] = n - i;
+    compareSorts("reverse", nodes, keys, n);
+
+    // Sorted, then a few out-of-order appends
+    for (int i = 0; i < n; i++) keys[i] = i;
+    for (int i = n - n / 100; i < n; i++) keys[i] = nextKey() % n;
+    compareSorts("sorted + 1% appended", nodes, keys, n);
+
+    // Sorted with 1% of positions swapped at random
+    for (int i = 0; i < n; i++) keys[i] = i;
+    for (int i = 0; i < n / 100; i++) {
+        int a = nextKey() % n, b = nextKey() % n;
+        int t = keys[a]; keys[a] = keys[b]; keys[b] = t;
+    }
+    compareSorts("1% swapped", nodes, keys, n);
+
+    for (int i = 0; i < n; i++) keys[i] = nextKey();
+    compareSorts("random", nodes, keys, n);
+
+    for (int i = 0; i < n; i++) free(nodes[i]);
+    free(nodes);
+    free(keys);
+}
+
+// The textbook array merge: one data-dependent branch per output key
+static void mergeBranchy32(const int32_t* a, size_t na, const int32_t* b, size_t nb, int32_t* out) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        if (a[i] <= b[j]) out[k++] = a[i++];
+        else out[k++] = b[j++];
+    }
+    while (i < na) out[k++] = a[i++];
+    while (j < nb) out[k++] = b[j++];
+}
+
+static void mergeBranchy64(const int64_t* a, size_t na, const int64_t* b, size_t nb, int64_t* out) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        if (a[i] <= b[j]) out[k++] = a[i++];
+        else out[k++] = b[j++];
+    }
+    while (i < na) out[k++] = a[i++];
+    while (j < nb) out[k++] = b[j++];
+}
+
+static int compareInt64(const void* x, const void* y) {
+    int64_t a = *(const int64_t*)x, b = *(const int64_t*)y;
+    return (a > b) - (a < b);
+}
 
-    // Base case: 0 or 1 element is already sorted
-    if (head == NULL || head->next == NULL) {
-        return;
+// Times 'reps' merges of two sorted n-key runs with each kernel and checks
+// every kernel's output against the branchy merge
+void runSimdBenchmark(size_t n, int reps) {
+    int64_t* a64 = (int64_t*)malloc(n * sizeof(int64_t));
+    int64_t* b64 = (int64_t*)malloc(n * sizeof(int64_t));
+    int64_t* out64 = (int64_t*)malloc(2 * n * sizeof(int64_t));
+    int64_t* ref64 = (int64_t*)malloc(2 * n * sizeof(int64_t));
+    int32_t* a32 = (int32_t*)malloc(n * sizeof(int32_t));
+    int32_t* b32 = (int32_t*)malloc(n * sizeof(int32_t));
+    int32_t* out32 = (int32_t*)malloc(2 * n * sizeof(int32_t));
+    int32_t* ref32 = (int32_t*)malloc(2 * n * sizeof(int32_t));
+    if (!a64 || !b64 || !out64 || !ref64 || !a32 || !b32 || !out32 || !ref32) {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
+    // Interleaved random runs: the next key is equally likely to come from either
+    for (size_t i = 0; i < n; i++) {
+        a64[i] = ((int64_t)nextKey() << 31 | nextKey()) - ((int64_t)1 << 61);
+        b64[i] = ((int64_t)nextKey() << 31 | nextKey()) - ((int64_t)1 << 61);
     }
+    qsort(a64, n, sizeof(int64_t), compareInt64);
+    qsort(b64, n, sizeof(int64_t), compareInt64);
+    for (size_t i = 0; i < n; i++) {
+        a32[i] = (int32_t)(a64[i] >> 32);
+        b32[i] = (int32_t)(b64[i] >> 32);
+    }
+
+#ifdef __AVX2__
+    const char* simd = "AVX2 bitonic";
+#else
+    const char* simd = "no AVX2, scalar";
+#endif
+    printf("--- Merge kernels: two sorted runs of %zu keys (%s) ---\n", n, simd);
+    printf("%-8s %-14s %14s %10s %8s\n", "keys", "kernel", "Mkeys/s", "speedup", "correct");
+
+    double start, branchy;
+    int ok;
+
+    mergeBranchy32(a32, n, b32, n, ref32);
+    start = nowSeconds();
+    for (int r = 0; r < reps; r++) mergeBranchy32(a32, n, b32, n, out32);
+    branchy = nowSeconds() - start;
+    printf("%-8s %-14s %14.1f %9.2fx %8s\n", "int32", "branchy", 2.0 * n * reps / branchy / 1e6, 1.0, "-");
 
-    // Divide: Split head into 'a' and 'b' sublists
-    FrontBackSplit(head, &a, &b);
+    start = nowSeconds();
+    for (int r = 0; r < reps; r++) mergeBranchless32(a32, n, b32, n, out32);
+    double elapsed = nowSeconds() - start;
+    ok = memcmp(out32, ref32, 2 * n * sizeof(int32_t)) == 0;
+    printf("%-8s %-14s %14.1f %9.2fx %8s\n", "int32", "branchless", 2.0 * n * reps / elapsed / 1e6,
+           branchy / elapsed, ok ? "yes" : "NO");
 
-    // Conquer: Recursively sort the sublists
-    MergeSort(&a);
-    MergeSort(&b);
+    start = nowSeconds();
+    for (int r = 0; r < reps; r++) mergeInt32(a32, n, b32, n, out32);
+    elapsed = nowSeconds() - start;
+    ok = memcmp(out32, ref32, 2 * n * sizeof(int32_t)) == 0;
+    printf("%-8s %-14s %14.1f %9.2fx %8s\n", "int32", "mergeInt32", 2.0 * n * reps / elapsed / 1e6,
+           branchy / elapsed, ok ? "yes" : "NO");
 
-    // Combine: Merge the two sorted lists
-    *headRef = SortedMerge(a, b);
+    mergeBranchy64(a64, n, b64, n, ref64);
+    start = nowSeconds();
+    for (int r = 0; r < reps; r++) mergeBranchy64(a64, n, b64, n, out64);
+    branchy = nowSeconds() - start;
+    printf("%-8s %-14s %14.1f %9.2fx %8s\n", "int64", "branchy", 2.0 * n * reps / branchy / 1e6, 1.0, "-");
+
+    start = nowSeconds();
+    for (int r = 0; r < reps; r++) mergeBranchless64(a64, n, b64, n, out64);
+    elapsed = nowSeconds() - start;
+    ok = memcmp(out64, ref64, 2 * n * sizeof(int64_t)) == 0;
+    printf("%-8s %-14s %14.1f %9.2fx %8s\n", "int64", "branchless", 2.0 * n * reps / elapsed / 1e6,
+           branchy / elapsed, ok ? "yes" : "NO");
+
+    start = nowSeconds();
+    for (int r = 0; r < reps; r++) mergeInt64(a64, n, b64, n, out64);
+    elapsed = nowSeconds() - start;
+    ok = memcmp(out64, ref64, 2 * n * sizeof(int64_t)) == 0;
+    printf("%-8s %-14s %14.1f %9.2fx %8s\n", "int64", "mergeInt64", 2.0 * n * reps / elapsed / 1e6,
+           branchy / elapsed, ok ? "yes" : "NO");
+
+    free(a64); free(b64); free(out64); free(ref64);
+    free(a32); free(b32); free(out32); free(ref32);
+}
+
+static long long sumList(struct Node* node) {
+    long long sum = 0;
+    for (; node != NULL; node = node->next) sum += node->data;
+    return sum;
+}
+
+// Build, sort, traverse and free an n-node list with malloc'd nodes and
+// with an arena, plus traversal after compacting the sorted arena list
+void runArenaBenchmark(int n) {
+    int* keys = (int*)malloc((size_t)n * sizeof(int));
+    if (keys == NULL) {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
+    for (int i = 0; i < n; i++) keys[i] = nextKey();
+
+    printf("--- malloc nodes vs node arena (%d nodes) ---\n", n);
+    printf("%-18s %14s %14s\n", "phase (ms)", "malloc", "arena");
+
+    double start = nowSeconds();
+    struct Node* heap = buildList(keys, n);
+    double buildHeap = nowSeconds() - start;
+
+    struct NodeArena arena;
+    arenaInit(&arena);
+    start = nowSeconds();
+    struct Node dummy;
+    struct Node* tail = &dummy;
+    for (int i = 0; i < n; i++) {
+        tail->next = arenaNode(&arena, keys[i]);
+        tail = tail->next;
+    }
+    tail->next = NULL;
+    struct Node* pooled = dummy.next;
+    double buildArena = nowSeconds() - start;
+    printf("%-18s %14.2f %14.2f\n", "build", buildHeap * 1e3, buildArena * 1e3);
+
+    start = nowSeconds();
+    MergeSort(&heap);
+    double sortHeap = nowSeconds() - start;
+    start = nowSeconds();
+    MergeSort(&pooled);
+    printf("%-18s %14.2f %14.2f\n", "sort", sortHeap * 1e3, (nowSeconds() - start) * 1e3);
+
+    start = nowSeconds();
+    long long checkHeap = sumList(heap);
+    double walkHeap = nowSeconds() - start;
+    start = nowSeconds();
+    long long checkArena = sumList(pooled);
+    printf("%-18s %14.2f %14.2f\n", "traverse sorted", walkHeap * 1e3, (nowSeconds() - start) * 1e3);
+
+    start = nowSeconds();
+    pooled = arenaCompact(&arena, pooled);
+    double compact = nowSeconds() - start;
+    start = nowSeconds();
+    long long checkCompact = sumList(pooled);
+    printf("%-18s %14s %14.2f\n", "compact", "-", compact * 1e3);
+    printf("%-18s %14s %14.2f\n", "traverse compacted", "-", (nowSeconds() - start) * 1e3);
+    int ok = isSorted(heap, n) && isSorted(pooled, n) && checkHeap == checkArena && checkArena == checkCompact;
+
+    start = nowSeconds();
+    deleteList(heap);
+    double freeHeap = nowSeconds() - start;
+    start = nowSeconds();
+    arenaRelease(&arena);
+    printf("%-18s %14.2f %14.2f\n", "free", freeHeap * 1e3, (nowSeconds() - start) * 1e3);
+    printf("sorted and equal: %s\n", ok ? "yes" : "NO");
+    free(keys);
 }
 
 // --- Main Program ---
-int main() {
+// Build:  gcc -O2 -march=native merge.c -o merge
+// Usage: ./merge              (demo)
+//        ./merge bench [max nodes]
+//        ./merge bench-natural [nodes]
+//        ./merge bench-simd [keys per run] [repetitions]
+//        ./merge bench-arena [nodes]
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        runBenchmark(argc > 2 ? atoi(argv[2]) : 10000000);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "bench-arena") == 0) {
+        runArenaBenchmark(argc > 2 ? atoi(argv[2]) : 10000000);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "bench-simd") == 0) {
+        runSimdBenchmark(argc > 2 ? (size_t)atol(argv[2]) : 1000000, argc > 3 ? atoi(argv[3]) : 20);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "bench-natural") == 0) {
+        runNaturalBenchmark(argc > 2 ? atoi(argv[2]) : 1000000);
+        return 0;
+    }
+
     // Create the unsorted linked list: 4 -> 2 -> 1 -> 5 -> 3
     struct Node* head = newNode(4);
     head->next = newNode(2);
@@ -0,0 +1,115 @@
+#ifndef MULTI_QUEUE_HPP
+#define MULTI_QUEUE_HPP
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <type_traits>
+#include <cstdint>
+#include "priority_heap.hpp"
+
+/**
+ * @brief Relaxed concurrent max-priority queue (MultiQueue).
+ *
+ * c * T independent BinaryHeaps, each behind its own lock. push() goes to a
+ * random heap; pop() samples two heaps and takes from the one whose top is
+ * better. Threads rarely meet on the same lock, so throughput scales with
+ * the thread count, at the price of strict order: a pop returns an element
+ * close to, but not always, the current maximum. The expected rank error
+ * is O(c * T).
+ *
+ * Each heap publishes its size and top in atomics so that sampling reads no
+ * lock; T must therefore be trivially copyable (keys, handles, small PODs).
+ */
+template <typename T, typename Compare = std::less<T>>
+class MultiQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "tops are published through std::atomic<T>");
+
+public:
+    explicit MultiQueue(size_t threads, size_t queuesPerThread = 2, Compare cmp = Compare())
+        : numShards(threads * queuesPerThread < 2 ? 2 : threads * queuesPerThread),
+          shards(new Shard[numShards]), cmp(cmp) {}
+
+    size_t shardCount() const { return numShards; }
+
+    void push(const T& value) {
+        for (;;) {
+            Shard& s = shards[randomShard()];
+            if (!s.lock.try_lock()) continue; // Busy; another heap will do
+            s.heap.push(value);
+            publish(s);
+            s.lock.unlock();
+            return;
+        }
+    }
+
+    // Pops an element near the top. Returns false only when every heap was
+    // seen empty in a final locked sweep.
+    bool tryPop(T& out) {
+        for (int attempt = 0; attempt < 64; attempt++) {
+            Shard& a = shards[randomShard()];
+            Shard& b = shards[randomShard()];
+            Shard* s = better(a, b);
+            if (s == nullptr) continue; // Both sampled heaps empty
+            if (!s->lock.try_lock()) continue;
+            bool ok = !s->heap.empty();
+            if (ok) {
+                out = s->heap.pop();
+                publish(*s);
+            }
+            s->lock.unlock();
+            if (ok) return true;
+        }
+        // Sampling keeps missing: the queue is empty or nearly so
+        for (size_t i = 0; i < numShards; i++) {
+            std::lock_guard<std::mutex> guard(shards[i].lock);
+            if (!shards[i].heap.empty()) {
+                out = shards[i].heap.pop();
+                publish(shards[i]);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::mutex lock;
+        BinaryHeap<T, Compare> heap;
+        std::atomic<size_t> size{0};
+        std::atomic<T> top{};
+    };
+
+    size_t numShards;
+    std::unique_ptr<Shard[]> shards;
+    Compare cmp;
+
+    // Must be called with s.lock held
+    static void publish(Shard& s) {
+        if (!s.heap.empty()) s.top.store(s.heap.top(), std::memory_order_relaxed);
+        s.size.store(s.heap.size(), std::memory_order_release);
+    }
+
+    // The sampled shard with the better published top, or null if both are empty
+    Shard* better(Shard& a, Shard& b) const {
+        bool hasA = a.size.load(std::memory_order_acquire) > 0;
+        bool hasB = b.size.load(std::memory_order_acquire) > 0;
+        if (!hasA) return hasB ? &b : nullptr;
+        if (!hasB) return &a;
+        return cmp(a.top.load(std::memory_order_relaxed), b.top.load(std::memory_order_relaxed)) ? &b : &a;
+    }
+
+    // Per-thread xorshift, so sampling shares no state between threads
+    size_t randomShard() const {
+        static thread_local uint64_t state = 0;
+        if (state == 0) state = (uint64_t)(uintptr_t)&state * 0x9e3779b97f4a7c15ULL | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return (size_t)(((state >> 32) * numShards) >> 32);
+    }
+};
+
+#endif // MULTI_QUEUE_HPP
@@ -0,0 +1,212 @@
+#ifndef PAIRING_HEAP_HPP
+#define PAIRING_HEAP_HPP
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <utility>
+#include <cstddef>
+#include <cassert>
+
+template <typename T>
+struct PairingNode {
+    T value;
+    PairingNode* child = nullptr;   // Leftmost child
+    PairingNode* sibling = nullptr; // Next sibling to the right
+    PairingNode* prev = nullptr;    // Left sibling, or parent for a leftmost child
+};
+
+/**
+ * @brief Chunked free-list allocator for pairing-heap nodes.
+ *
+ * Nodes are carved from 1024-node chunks and recycled through a free list,
+ * so insert never calls the general-purpose allocator once the pool is warm
+ * and node addresses stay stable (they double as handles). Heaps that share
+ * a pool can be melded in O(1).
+ */
+template <typename T>
+class PairingNodePool {
+public:
+    using Node = PairingNode<T>;
+
+    PairingNodePool() = default;
+    PairingNodePool(const PairingNodePool&) = delete;
+    PairingNodePool& operator=(const PairingNodePool&) = delete;
+
+    Node* allocate(const T& value) {
+        if (freeList == nullptr) grow();
+        Node* n = freeList;
+        freeList = n->sibling;
+        n->value = value;
+        n->child = n->sibling = n->prev = nullptr;
+        return n;
+    }
+
+    void release(Node* n) {
+        n->sibling = freeList;
+        freeList = n;
+    }
+
+    // Pool used by heaps constructed without one; shared by the calling thread
+    static PairingNodePool& threadPool() {
+        static thread_local PairingNodePool pool;
+        return pool;
+    }
+
+private:
+    static constexpr size_t CHUNK = 1024;
+    std::vector<std::unique_ptr<Node[]>> chunks;
+    Node* freeList = nullptr;
+
+    void grow() {
+        chunks.emplace_back(new Node[CHUNK]);
+        Node* chunk = chunks.back().get();
+        for (size_t i = 0; i < CHUNK; i++) {
+            chunk[i].sibling = freeList;
+            freeList = &chunk[i];
+        }
+    }
+};
+
+/**
+ * @brief Meldable max-heap (two-pass pairing heap) over pooled nodes.
+ *
+ * insert() and meld() link two roots in O(1); deleteMax() pairs up the root's
+ * children left to right and folds the pairs right to left, amortized
+ * O(log n). insert() returns a handle that increase_key() accepts until the
+ * element is deleted: the node is cut from its parent and linked with the
+ * root. All links are iterative, so degenerate shapes cannot blow the stack.
+ */
+template <typename T, typename Compare = std::less<T>>
+class PairingHeap {
+public:
+    using Node = PairingNode<T>;
+    using Handle = Node*;
+
+    explicit PairingHeap(PairingNodePool<T>& pool = PairingNodePool<T>::threadPool(), Compare cmp = Compare())
+        : pool(&pool), cmp(std::move(cmp)) {}
+    PairingHeap(const PairingHeap&) = delete;
+    PairingHeap& operator=(const PairingHeap&) = delete;
+    ~PairingHeap() { clear(); }
+
+    bool empty() const { return root == nullptr; }
+    size_t size() const { return count; }
+
+    // Highest-priority element. Precondition: !empty()
+    const T& top() const {
+        assert(root != nullptr);
+        return root->value;
+    }
+
+    Handle insert(const T& value) {
+        Node* n = pool->allocate(value);
+        root = root ? link(root, n) : n;
+        count++;
+        return n;
+    }
+
+    // Removes and returns the highest-priority element. Precondition: !empty()
+    T deleteMax() {
+        assert(root != nullptr);
+        Node* old = root;
+        T result = std::move(old->value);
+        root = mergePairs(old->child);
+        pool->release(old);
+        count--;
+        return result;
+    }
+
+    // Raises the priority of a queued element. Precondition: value is not
+    // worse than its current one
+    void increase_key(Handle h, const T& value) {
+        assert(!cmp(value, h->value));
+        h->value = value;
+        if (h == root) return;
+        if (h->prev->child == h) h->prev->child = h->sibling; // Leftmost: parent points at h
+        else h->prev->sibling = h->sibling;
+        if (h->sibling) h->sibling->prev = h->prev;
+        h->sibling = h->prev = nullptr;
+        root = link(root, h);
+    }
+
+    // Moves every element of 'other' into this heap in O(1). Both heaps
+    // must allocate from the same pool; 'other' is left empty.
+    void meld(PairingHeap& other) {
+        assert(pool == other.pool);
+        if (other.root == nullptr || &other == this) return;
+        root = root ? link(root, other.root) : other.root;
+        count += other.count;
+        other.root = nullptr;
+        other.count = 0;
+    }
+
+    // Returns every node to the pool
+    void clear() {
+        Node* stack = root; // Pending subtrees, chained through 'sibling'
+        while (stack) {
+            Node* n = stack;
+            stack = n->sibling;
+            for (Node* c = n->child; c;) {
+                Node* next = c->sibling;
+                c->sibling = stack;
+                stack = c;
+                c = next;
+            }
+            pool->release(n);
+        }
+        root = nullptr;
+        count = 0;
+    }
+
+private:
+    PairingNodePool<T>* pool;
+    Node* root = nullptr;
+    size_t count = 0;
+    Compare cmp;
+
+    // Links two roots: the worse becomes the leftmost child of the better
+    Node* link(Node* a, Node* b) {
+        if (cmp(a->value, b->value)) std::swap(a, b);
+        b->sibling = a->child;
+        if (a->child) a->child->prev = b;
+        b->prev = a;
+        a->child = b;
+        a->sibling = a->prev = nullptr;
+        return a;
+    }
+
+    // Two-pass merge of a sibling list into a single root
+    Node* mergePairs(Node* first) {
+        if (first == nullptr) return nullptr;
+        // Pass 1: link neighbours pairwise, collecting results in reverse order
+        Node* pairs = nullptr;
+        while (first) {
+            Node* a = first;
+            Node* b = a->sibling;
+            Node* merged;
+            if (b) {
+                first = b->sibling;
+                merged = link(a, b);
+            } else {
+                first = nullptr;
+                merged = a;
+            }
+            merged->sibling = pairs;
+            pairs = merged;
+        }
+        // Pass 2: fold right to left
+        Node* result = pairs;
+        pairs = pairs->sibling;
+        result->sibling = nullptr;
+        while (pairs) {
+            Node* next = pairs->sibling;
+            pairs->sibling = nullptr;
+            result = link(result, pairs);
+            pairs = next;
+        }
+        result->prev = nullptr;
+        return result;
+    }
+};
+
+#endif // PAIRING_HEAP_HPP
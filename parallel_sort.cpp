@@ -0,0 +1,69 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <execution>
+#include <thread>
+#include <cstdint>
+#include "parallel_sort.hpp"
+
+// User information: Always use namespace std.
+using namespace std;
+
+using Clock = chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+static void printRow(const string& name, size_t n, double seconds) {
+    cout << "  " << left << setw(30) << name << right << fixed << setprecision(1)
+         << setw(10) << seconds * 1e3 << " ms" << setw(10) << n / seconds / 1e6 << " M/s" << endl;
+}
+
+// Sorts the same random keys with parallel_merge_sort at 1, 2, 4, ... up to
+// maxThreads, then with std::sort and std::sort(std::execution::par)
+template <typename T>
+void runBenchmark(const string& type, size_t n, size_t maxThreads) {
+    cout << "--- " << type << ", " << n << " keys ---" << endl;
+    mt19937_64 rng(42);
+    vector<T> keys(n);
+    for (auto& k : keys) k = (T)rng();
+
+    vector<T> expected = keys;
+    auto t = Clock::now();
+    sort(expected.begin(), expected.end());
+    double stdSort = secondsSince(t);
+
+    vector<T> work;
+    for (size_t threads = 1;; threads = min(threads * 2, maxThreads)) {
+        WorkStealingPool pool(threads);
+        work = keys;
+        t = Clock::now();
+        parallel_merge_sort(pool, work.data(), n);
+        double elapsed = secondsSince(t);
+        printRow("parallel_merge_sort, " + to_string(threads) + " thr", n, elapsed);
+        if (work != expected) cout << "  output differs from std::sort!" << endl;
+        if (threads == maxThreads) break;
+    }
+
+    printRow("std::sort", n, stdSort);
+    work = keys;
+    t = Clock::now();
+    sort(execution::par, work.begin(), work.end());
+    printRow("std::sort(execution::par)", n, secondsSince(t));
+}
+
+// Build:  g++ -std=c++17 -O2 -march=native parallel_sort.cpp -o parallel_sort -pthread -ltbb
+// Usage: ./parallel_sort [n] [max threads]
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? stoul(argv[1]) : 100000000;
+    size_t maxThreads = argc > 2 ? stoul(argv[2]) : max(1u, thread::hardware_concurrency());
+
+    runBenchmark<int32_t>("int32", n, maxThreads);
+    runBenchmark<int64_t>("int64", n, maxThreads);
+    return 0;
+}
@@ -0,0 +1,137 @@
+#ifndef PARALLEL_SORT_HPP
+#define PARALLEL_SORT_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include "work_stealing.hpp"
+#include "simd_merge.h"
+
+/**
+ * @brief Parallel merge sort for contiguous arrays of integer keys.
+ *
+ * The array is split recursively; each half becomes a task on a
+ * WorkStealingPool, so idle threads pick up the largest outstanding
+ * subproblems. Runs ping-pong between the input and one scratch buffer of
+ * the same size, so each level moves every element exactly once.
+ *
+ * Merges are parallel too: a merge of more than MERGE_CUTOFF elements picks
+ * the midpoint of the output and co-ranks it (binary search for how many of
+ * those outputs come from each input), which splits both inputs into two
+ * independent merges that run as separate tasks. Without this the final
+ * merge alone would be a sequential O(n) tail.
+ *
+ * Below TASK_CUTOFF elements a subarray is sorted sequentially, and runs of
+ * INSERTION_CUTOFF elements or fewer use insertion sort. Sequential merges of
+ * int32/int64 keys use the AVX2 bitonic kernels from simd_merge.h (those do
+ * not order equal keys, which only matters for other key types).
+ */
+namespace parallel_sort_detail {
+
+constexpr size_t INSERTION_CUTOFF = 24;
+constexpr size_t TASK_CUTOFF = 1 << 15;
+constexpr size_t MERGE_CUTOFF = 1 << 16;
+
+template <typename T>
+void insertionSort(T* a, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        T v = a[i];
+        size_t j = i;
+        while (j > 0 && v < a[j - 1]) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = v;
+    }
+}
+
+// Stable sequential merge of a[0..na) and b[0..nb) into out
+template <typename T>
+void mergeSequential(const T* a, size_t na, const T* b, size_t nb, T* out) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        // Ties take from 'a', which holds the earlier elements
+        bool takeB = b[j] < a[i];
+        out[k++] = takeB ? b[j] : a[i];
+        j += takeB;
+        i += !takeB;
+    }
+    std::copy(a + i, a + na, out + k);
+    std::copy(b + j, b + nb, out + k + (na - i));
+}
+
+// Plain integer keys go through the vectorized kernels
+inline void mergeSequential(const int32_t* a, size_t na, const int32_t* b, size_t nb, int32_t* out) {
+    mergeInt32(a, na, b, nb, out);
+}
+inline void mergeSequential(const int64_t* a, size_t na, const int64_t* b, size_t nb, int64_t* out) {
+    mergeInt64(a, na, b, nb, out);
+}
+
+// Number of elements of 'a' among the first k outputs of a stable merge of
+// a[0..na) and b[0..nb); the rest (k - result) come from 'b'
+template <typename T>
+size_t coRank(size_t k, const T* a, size_t na, const T* b, size_t nb) {
+    size_t lo = k > nb ? k - nb : 0;
+    size_t hi = k < na ? k : na;
+    // Largest i in [lo, hi] such that a[i - 1] <= b[k - i] (a wins ties)
+    while (lo < hi) {
+        size_t i = lo + (hi - lo + 1) / 2;
+        if (a[i - 1] <= b[k - i]) lo = i;
+        else hi = i - 1;
+    }
+    return lo;
+}
+
+template <typename T>
+void mergeParallel(WorkStealingPool& pool, const T* a, size_t na, const T* b, size_t nb, T* out) {
+    size_t n = na + nb;
+    if (n <= MERGE_CUTOFF) {
+        mergeSequential(a, na, b, nb, out);
+        return;
+    }
+    size_t k = n / 2;
+    size_t i = coRank(k, a, na, b, nb);
+    size_t j = k - i;
+    TaskGroup group;
+    pool.spawn(group, [&pool, a, i, b, j, out] { mergeParallel(pool, a, i, b, j, out); });
+    mergeParallel(pool, a + i, na - i, b + j, nb - j, out + k);
+    pool.wait(group);
+}
+
+// Sorts src[0..n). The result ends up in src when 'intoScratch' is false and
+// in scratch otherwise; the other buffer's contents are clobbered.
+template <typename T>
+void sortRange(WorkStealingPool* pool, T* src, T* scratch, size_t n, bool intoScratch) {
+    if (n <= INSERTION_CUTOFF) {
+        insertionSort(src, n);
+        if (intoScratch) std::copy(src, src + n, scratch);
+        return;
+    }
+    size_t half = n / 2;
+    // Children leave their halves in the buffer this level merges from
+    if (pool != nullptr && n > TASK_CUTOFF) {
+        TaskGroup group;
+        pool->spawn(group, [=] { sortRange(pool, src, scratch, half, !intoScratch); });
+        sortRange(pool, src + half, scratch + half, n - half, !intoScratch);
+        pool->wait(group);
+    } else {
+        sortRange<T>(nullptr, src, scratch, half, !intoScratch);
+        sortRange<T>(nullptr, src + half, scratch + half, n - half, !intoScratch);
+    }
+    const T* from = intoScratch ? src : scratch;
+    T* to = intoScratch ? scratch : src;
+    if (pool != nullptr) mergeParallel(*pool, from, half, from + half, n - half, to);
+    else mergeSequential(from, half, from + half, n - half, to);
+}
+
+} // namespace parallel_sort_detail
+
+// Sorts values[0..n) ascending on 'pool'. Allocates one n-element scratch buffer.
+template <typename T>
+void parallel_merge_sort(WorkStealingPool& pool, T* values, size_t n) {
+    std::vector<T> scratch(n);
+    pool.run([&] { parallel_sort_detail::sortRange(&pool, values, scratch.data(), n, false); });
+}
+
+#endif // PARALLEL_SORT_HPP
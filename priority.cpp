@@ -0,0 +1,641 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <queue>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include "priority_heap.hpp"
+#include "indexed_heap.hpp"
+#include "multi_queue.hpp"
+#include "radix_heap.hpp"
+#include "pairing_heap.hpp"
+
+// User information: Always use namespace std.
+using namespace std;
+
+// --- Benchmark ---
+
+using Clock = chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+static volatile long long sink; // Keeps pop loops from being optimized away
+
+// An element with a payload, as a scheduler would queue it
+struct Job {
+    int priority;
+    int id;
+    double cost;
+};
+
+struct JobOrder {
+    bool operator()(const Job& a, const Job& b) const { return a.priority < b.priority; }
+};
+
+// Push n elements, then pop them all; returns {push seconds, pop seconds}
+template <typename Queue, typename Make>
+pair<double, double> pushPopRun(size_t n, Make make) {
+    Queue q;
+    auto t = Clock::now();
+    for (size_t i = 0; i < n; i++) q.push(make(i));
+    double push = secondsSince(t);
+    t = Clock::now();
+    while (!q.empty()) {
+        sink += q.top().priority;
+        q.pop();
+    }
+    return {push, secondsSince(t)};
+}
+
+// Thin wrapper so ints expose .priority like Job
+struct Int {
+    int priority;
+    bool operator<(const Int& o) const { return priority < o.priority; }
+};
+
+static void printRow(const string& name, size_t n, pair<double, double> ours, pair<double, double> theirs) {
+    cout << "  " << left << setw(14) << name << right << fixed << setprecision(1)
+         << setw(10) << n / ours.first / 1e6 << setw(10) << n / theirs.first / 1e6
+         << setw(10) << n / ours.second / 1e6 << setw(10) << n / theirs.second / 1e6
+         << setw(8) << setprecision(2) << (theirs.first + theirs.second) / (ours.first + ours.second) << "x" << endl;
+}
+
+void runBenchmark(size_t n) {
+    mt19937 rng(12345);
+    vector<int> keys(n);
+    for (auto& k : keys) k = (int)rng();
+
+    cout << "--- BinaryHeap vs std::priority_queue (" << n << " elements) ---" << endl;
+    cout << "  " << left << setw(14) << "element" << right
+         << setw(20) << "push (Mops/s)" << setw(20) << "pop (Mops/s)" << setw(9) << "total" << endl;
+    cout << "  " << setw(14) << "" << setw(10) << "ours" << setw(10) << "std"
+         << setw(10) << "ours" << setw(10) << "std" << endl;
+
+    auto makeInt = [&](size_t i) { return Int{keys[i]}; };
+    printRow("int", n, pushPopRun<BinaryHeap<Int>>(n, makeInt),
+             pushPopRun<priority_queue<Int>>(n, makeInt));
+
+    auto makeJob = [&](size_t i) { return Job{keys[i], (int)i, i * 0.5}; };
+    printRow("Job (16 B)", n, pushPopRun<BinaryHeap<Job, JobOrder>>(n, makeJob),
+             pushPopRun<priority_queue<Job, vector<Job>, JobOrder>>(n, makeJob));
+}
+
+// Push n keys then pop them all; returns nanoseconds per push and per pop
+template <typename Heap>
+pair<double, double> heapCost(const vector<int>& keys) {
+    Heap h;
+    size_t n = keys.size();
+    auto t = Clock::now();
+    for (int k : keys) h.push(k);
+    double push = secondsSince(t);
+    t = Clock::now();
+    while (!h.empty()) sink += h.pop();
+    double pop = secondsSince(t);
+    return {push / n * 1e9, pop / n * 1e9};
+}
+
+// Sweeps heap arity and size to show where the cache-aligned d-ary layout
+// overtakes the binary heap (int keys, so D = 8 and 16 use the SIMD path)
+void runAritySweep(size_t maxN) {
+    cout << "--- Binary vs d-ary heap, ns per push / ns per pop ---" << endl;
+    cout << left << setw(12) << "n" << right << setw(16) << "binary" << setw(16) << "d=4"
+         << setw(16) << "d=8" << setw(16) << "d=16" << endl;
+
+    mt19937 rng(99);
+    for (size_t n = 10000; n <= maxN; n *= 10) {
+        vector<int> keys(n);
+        for (auto& k : keys) k = (int)rng();
+
+        pair<double, double> r[] = {
+            heapCost<BinaryHeap<int>>(keys),
+            heapCost<DaryHeap<int, 4>>(keys),
+            heapCost<DaryHeap<int, 8>>(keys),
+            heapCost<DaryHeap<int, 16>>(keys),
+        };
+        cout << left << setw(12) << n << right << fixed << setprecision(1);
+        for (auto& x : r) cout << setw(8) << x.first << " /" << setw(6) << x.second;
+        cout << endl;
+    }
+}
+
+// Bulk load and top-k extraction: per-element pushes/pops against the
+// batched entry points, and heap-sort/partial-sort against std::
+void runBatchBenchmark(size_t n, size_t k) {
+    mt19937 rng(31);
+    vector<int> keys(n);
+    for (auto& key : keys) key = (int)rng();
+    auto row = [](const string& name, double ours, double baseline, const string& against) {
+        cout << "  " << left << setw(28) << name << right << fixed << setprecision(1) << setw(10) << ours * 1e3
+             << " ms" << setw(10) << baseline * 1e3 << " ms  " << left << setw(22) << against << right
+             << setprecision(2) << baseline / ours << "x" << endl;
+    };
+
+    cout << "--- Batched heap operations (" << n << " keys, k = " << k << ") ---" << endl;
+
+    auto t = Clock::now();
+    BinaryHeap<int> pushed;
+    for (int key : keys) pushed.push(key);
+    double pushEach = secondsSince(t);
+    t = Clock::now();
+    BinaryHeap<int> built(keys);
+    double build = secondsSince(t);
+    row("build_heap", build, pushEach, "(n x push)");
+
+    vector<int> more(keys.begin(), keys.begin() + n / 2);
+    t = Clock::now();
+    for (int key : more) pushed.push(key);
+    double pushMore = secondsSince(t);
+    t = Clock::now();
+    built.push_batch(more.begin(), more.end());
+    row("push_batch (n/2 more)", secondsSince(t), pushMore, "(n/2 x push)");
+
+    t = Clock::now();
+    for (size_t i = 0; i < k; i++) sink += pushed.pop();
+    double popEach = secondsSince(t);
+    t = Clock::now();
+    vector<int> top = built.pop_k(k);
+    row("pop_k", secondsSince(t), popEach, "(k x pop)");
+    sink += top.back();
+
+    vector<int> a = keys, b = keys;
+    t = Clock::now();
+    heap_sort(a);
+    double ours = secondsSince(t);
+    t = Clock::now();
+    sort(b.begin(), b.end());
+    row("heap_sort", ours, secondsSince(t), "(std::sort)");
+    if (a != b) cout << "  heap_sort output differs from std::sort!" << endl;
+
+    b = keys;
+    t = Clock::now();
+    top = partial_sort_top(keys, k);
+    ours = secondsSince(t);
+    t = Clock::now();
+    partial_sort(b.begin(), b.begin() + k, b.end(), greater<int>());
+    row("partial_sort_top", ours, secondsSince(t), "(std::partial_sort)");
+    if (!equal(top.begin(), top.end(), b.begin())) cout << "  partial_sort_top output differs!" << endl;
+}
+
+// Merge-heavy workload: each round, 'workers' per-worker queues are filled
+// with 'perWorker' keys and merged into a global queue, which then serves
+// half of its contents. The array heap must re-insert every element on a
+// merge (push_batch); the pairing heap melds in O(1).
+void runMeldBenchmark(size_t workers, size_t perWorker, size_t rounds) {
+    cout << "--- Pairing heap meld vs BinaryHeap merge (" << workers << " workers x " << perWorker
+         << " keys, " << rounds << " rounds) ---" << endl;
+    mt19937 rng(5);
+    vector<int> keys(workers * perWorker * rounds);
+    for (auto& k : keys) k = (int)rng();
+
+    double mergeArray = 0, totalArray = 0, mergePairing = 0, totalPairing = 0;
+    long long checkArray = 0, checkPairing = 0;
+    {
+        auto start = Clock::now();
+        BinaryHeap<int> global;
+        size_t next = 0;
+        for (size_t r = 0; r < rounds; r++) {
+            vector<BinaryHeap<int>> local(workers);
+            for (auto& q : local)
+                for (size_t i = 0; i < perWorker; i++) q.push(keys[next++]);
+            auto t = Clock::now();
+            for (auto& q : local) global.push_batch(q.items().begin(), q.items().end());
+            mergeArray += secondsSince(t);
+            for (size_t i = global.size() / 2; i > 0; i--) checkArray += global.pop();
+        }
+        totalArray = secondsSince(start);
+    }
+    {
+        auto start = Clock::now();
+        PairingNodePool<int> pool;
+        PairingHeap<int> global(pool);
+        size_t next = 0;
+        for (size_t r = 0; r < rounds; r++) {
+            vector<unique_ptr<PairingHeap<int>>> local;
+            for (size_t w = 0; w < workers; w++) local.emplace_back(new PairingHeap<int>(pool));
+            for (auto& q : local)
+                for (size_t i = 0; i < perWorker; i++) q->insert(keys[next++]);
+            auto t = Clock::now();
+            for (auto& q : local) global.meld(*q);
+            mergePairing += secondsSince(t);
+            for (size_t i = global.size() / 2; i > 0; i--) checkPairing += global.deleteMax();
+        }
+        totalPairing = secondsSince(start);
+    }
+
+    cout << left << setw(14) << "" << right << setw(14) << "merge (ms)" << setw(14) << "total (ms)" << endl;
+    cout << left << setw(14) << "BinaryHeap" << right << fixed << setprecision(2)
+         << setw(14) << mergeArray * 1e3 << setw(14) << totalArray * 1e3 << endl;
+    cout << left << setw(14) << "PairingHeap" << right
+         << setw(14) << mergePairing * 1e3 << setw(14) << totalPairing * 1e3 << endl;
+    if (checkArray != checkPairing) cout << "  popped keys differ!" << endl;
+}
+
+// Event at a simulated time, ordered so that BinaryHeap serves the earliest
+struct Event {
+    uint64_t time;
+    uint32_t id;
+    bool operator<(const Event& o) const { return time > o.time; }
+};
+
+// Hold model of a discrete-event simulation: 'pending' events are queued;
+// each step pops the earliest and schedules a successor up to 'maxDelay'
+// ticks later. Keys never decrease, which is what a radix heap needs.
+template <typename Run>
+double holdModel(size_t pending, size_t steps, uint64_t maxDelay, Run step) {
+    mt19937_64 rng(17);
+    auto t = Clock::now();
+    step(pending, steps, maxDelay, rng);
+    return secondsSince(t);
+}
+
+void runRadixBenchmark(size_t steps) {
+    cout << "--- Radix heap vs BinaryHeap, monotone event times (" << steps << " pop+push steps) ---" << endl;
+    cout << left << setw(12) << "pending" << setw(12) << "max delay" << right << setw(18) << "binary (ns/step)"
+         << setw(16) << "radix (ns/step)" << setw(10) << "speedup" << endl;
+
+    for (size_t pending : {1000, 100000, 1000000}) {
+        for (uint64_t maxDelay : {1000ULL, 1000000000ULL}) {
+            uint64_t checkBinary = 0, checkRadix = 0;
+            double tb = holdModel(pending, steps, maxDelay, [&](size_t p, size_t s, uint64_t d, mt19937_64& rng) {
+                BinaryHeap<Event> q;
+                for (size_t i = 0; i < p; i++) q.push({rng() % d, (uint32_t)i});
+                for (size_t i = 0; i < s; i++) {
+                    Event e = q.pop();
+                    checkBinary += e.time;
+                    q.push({e.time + 1 + rng() % d, e.id});
+                }
+            });
+            double tr = holdModel(pending, steps, maxDelay, [&](size_t p, size_t s, uint64_t d, mt19937_64& rng) {
+                RadixHeap<uint64_t, uint32_t> q;
+                for (size_t i = 0; i < p; i++) q.push(rng() % d, (uint32_t)i);
+                for (size_t i = 0; i < s; i++) {
+                    auto e = q.pop();
+                    checkRadix += e.first;
+                    q.push(e.first + 1 + rng() % d, e.second);
+                }
+            });
+            cout << left << setw(12) << pending << setw(12) << maxDelay << right << fixed << setprecision(1)
+                 << setw(18) << tb / steps * 1e9 << setw(16) << tr / steps * 1e9
+                 << setw(9) << setprecision(2) << tb / tr << "x" << endl;
+            // Ties pop in a different order, so only the popped times must agree
+            if (checkBinary != checkRadix) cout << "  popped times differ!" << endl;
+        }
+    }
+}
+
+// The lazy-deletion alternative to IndexedHeap: an update pushes a fresh
+// entry and bumps the element's version; stale entries are skipped on pop.
+class LazyQueue {
+public:
+    using Handle = uint32_t;
+
+    Handle push(int p) {
+        Handle h;
+        if (!freeIds.empty()) {
+            h = freeIds.back();
+            freeIds.pop_back();
+        } else {
+            h = (Handle)version.size();
+            version.push_back(0);
+            alive.push_back(false);
+        }
+        alive[h] = true;
+        heap.push({p, h, version[h]});
+        return h;
+    }
+
+    void update_priority(Handle h, int p) { heap.push({p, h, ++version[h]}); }
+
+    bool remove(Handle h) {
+        if (!alive[h]) return false;
+        alive[h] = false;
+        version[h]++;
+        freeIds.push_back(h);
+        return true;
+    }
+
+    pair<Handle, int> pop() {
+        for (;;) {
+            Entry e = heap.pop();
+            if (e.version == version[e.handle] && alive[e.handle]) {
+                remove(e.handle);
+                return {e.handle, e.priority};
+            }
+        }
+    }
+
+    size_t storedEntries() const { return heap.size(); }
+
+private:
+    struct Entry {
+        int priority;
+        Handle handle;
+        uint32_t version;
+        bool operator<(const Entry& o) const { return priority < o.priority; }
+    };
+    BinaryHeap<Entry> heap;
+    vector<uint32_t> version;
+    vector<bool> alive;
+    vector<Handle> freeIds;
+};
+
+// Runs 'ops' operations on a queue holding n elements: updatePercent% change
+// a random element's priority, and the rest are split between cancelling a
+// random element and popping the top (each followed by a push to keep n)
+template <typename Queue>
+double updateWorkload(Queue& q, size_t n, size_t ops, int updatePercent) {
+    mt19937 rng(2024);
+    vector<uint32_t> live, livePos;
+    auto track = [&](uint32_t h) {
+        if (h >= livePos.size()) livePos.resize(h + 1);
+        livePos[h] = (uint32_t)live.size();
+        live.push_back(h);
+    };
+    auto untrack = [&](uint32_t h) {
+        uint32_t i = livePos[h];
+        live[i] = live.back();
+        livePos[live[i]] = i;
+        live.pop_back();
+    };
+
+    for (size_t i = 0; i < n; i++) track(q.push((int)rng()));
+
+    auto t = Clock::now();
+    for (size_t i = 0; i < ops; i++) {
+        int r = (int)(rng() % 100);
+        if (r < updatePercent) {
+            q.update_priority(live[rng() % live.size()], (int)rng());
+        } else if (r < updatePercent + (100 - updatePercent) / 2) {
+            uint32_t h = live[rng() % live.size()];
+            q.remove(h);
+            untrack(h);
+            track(q.push((int)rng()));
+        } else {
+            untrack(q.pop().first);
+            track(q.push((int)rng()));
+        }
+    }
+    return secondsSince(t);
+}
+
+void runUpdateBenchmark(size_t n, size_t ops) {
+    cout << "--- IndexedHeap vs lazy deletion (" << n << " queued, " << ops << " ops) ---" << endl;
+    cout << left << setw(12) << "updates" << right << setw(18) << "indexed (Mops/s)"
+         << setw(16) << "lazy (Mops/s)" << setw(10) << "speedup" << setw(22) << "lazy entries stored" << endl;
+
+    for (int updatePercent : {0, 50, 80, 95}) {
+        IndexedHeap<int> indexed;
+        double ti = updateWorkload(indexed, n, ops, updatePercent);
+        LazyQueue lazy;
+        double tl = updateWorkload(lazy, n, ops, updatePercent);
+        cout << left << setw(12) << to_string(updatePercent) + "%" << right << fixed << setprecision(2)
+             << setw(18) << ops / ti / 1e6 << setw(16) << ops / tl / 1e6
+             << setw(9) << tl / ti << "x" << setw(22) << lazy.storedEntries() << endl;
+    }
+}
+
+// The single-lock baseline a shared worker-pool queue starts from
+class LockedQueue {
+public:
+    explicit LockedQueue(size_t) {}
+
+    void push(int value) {
+        lock_guard<mutex> guard(lock);
+        heap.push(value);
+    }
+
+    bool tryPop(int& out) {
+        lock_guard<mutex> guard(lock);
+        return heap.tryPop(out);
+    }
+
+private:
+    mutex lock;
+    BinaryHeap<int> heap;
+};
+
+// Each thread alternates push and pop on a queue prefilled with 'prefill'
+// keys; returns total operations per second
+template <typename Queue>
+double concurrentThroughput(size_t threads, size_t opsPerThread, size_t prefill) {
+    Queue q(threads);
+    mt19937 rng(7);
+    for (size_t i = 0; i < prefill; i++) q.push((int)(rng() >> 1));
+
+    atomic<bool> go{false};
+    vector<thread> pool;
+    for (size_t t = 0; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            mt19937 local((unsigned)t + 1);
+            int out;
+            long long sum = 0;
+            while (!go.load()) this_thread::yield();
+            for (size_t i = 0; i < opsPerThread; i += 2) {
+                q.push((int)(local() >> 1));
+                if (q.tryPop(out)) sum += out;
+            }
+            sink += sum;
+        });
+    }
+    auto t = Clock::now();
+    go = true;
+    for (auto& th : pool) th.join();
+    return threads * opsPerThread / secondsSince(t);
+}
+
+void runConcurrentBenchmark(size_t maxThreads, size_t opsPerThread) {
+    cout << "--- MultiQueue vs single-lock heap (" << opsPerThread << " ops/thread, 1e6 prefilled) ---" << endl;
+    cout << left << setw(10) << "threads" << right << setw(20) << "locked (Mops/s)"
+         << setw(22) << "MultiQueue (Mops/s)" << setw(10) << "speedup" << endl;
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        double locked = concurrentThroughput<LockedQueue>(threads, opsPerThread, 1000000);
+        double multi = concurrentThroughput<MultiQueue<int>>(threads, opsPerThread, 1000000);
+        cout << left << setw(10) << threads << right << fixed << setprecision(2)
+             << setw(20) << locked / 1e6 << setw(22) << multi / 1e6 << setw(9) << multi / locked << "x" << endl;
+    }
+}
+
+// Counts how many keys still queued outrank each popped key (0 = strict order)
+class RankTracker {
+public:
+    explicit RankTracker(size_t n) : tree(n + 1, 0), present(0) {
+        for (size_t k = 0; k < n; k++) add(k, 1);
+    }
+
+    // Rank error of popping key k, which then leaves the queue
+    size_t pop(size_t k) {
+        size_t rank = present - prefix(k + 1);
+        add(k, -1);
+        return rank;
+    }
+
+private:
+    vector<int> tree; // Fenwick tree over keys 0..n-1
+    size_t present;
+
+    void add(size_t k, int delta) {
+        present += delta;
+        for (size_t i = k + 1; i < tree.size(); i += i & (0 - i)) tree[i] += delta;
+    }
+    size_t prefix(size_t count) const {
+        size_t sum = 0;
+        for (size_t i = count; i > 0; i -= i & (0 - i)) sum += tree[i];
+        return sum;
+    }
+};
+
+// Prefills a permutation of 0..n-1, drains it with 'threads' poppers, and
+// replays the pops in the order they were ticketed to measure rank error.
+// A pop is ticketed just after it returns, so under contention the
+// linearization is approximate (the locked baseline shows the noise floor).
+// With more threads than cores, a thread preempted while holding a heap's
+// lock strands that heap's top for a time slice, which also shows up here.
+template <typename Queue>
+void measureRankError(const string& name, size_t threads, size_t n) {
+    Queue q(threads);
+    vector<int> keys(n);
+    for (size_t i = 0; i < n; i++) keys[i] = (int)i;
+    shuffle(keys.begin(), keys.end(), mt19937(3));
+    for (int k : keys) q.push(k);
+
+    vector<int> order(n);
+    atomic<size_t> ticket{0};
+    vector<thread> pool;
+    for (size_t t = 0; t < threads; t++) {
+        pool.emplace_back([&] {
+            int k;
+            while (q.tryPop(k)) order[ticket.fetch_add(1)] = k;
+        });
+    }
+    for (auto& th : pool) th.join();
+
+    RankTracker tracker(n);
+    vector<size_t> errors(n);
+    double total = 0;
+    for (size_t i = 0; i < n; i++) {
+        errors[i] = tracker.pop((size_t)order[i]);
+        total += errors[i];
+    }
+    sort(errors.begin(), errors.end());
+    cout << left << setw(14) << name << setw(10) << threads << right << fixed << setprecision(2)
+         << setw(12) << total / n << setw(10) << errors[n * 99 / 100] << setw(10) << errors.back() << endl;
+}
+
+void runRankError(size_t maxThreads, size_t n) {
+    cout << "--- Rank error of pops (" << n << " keys; rank = queued keys that outrank the popped one) ---" << endl;
+    cout << left << setw(14) << "queue" << setw(10) << "threads" << right
+         << setw(12) << "mean" << setw(10) << "p99" << setw(10) << "max" << endl;
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        measureRankError<LockedQueue>("locked", threads, n);
+        measureRankError<MultiQueue<int>>("MultiQueue", threads, n);
+    }
+}
+
+// --- Menu Helpers ---
+
+// Display the heap (priority queue)
+void display(const BinaryHeap<int>& pq) {
+    if (pq.empty()) {
+        cout << "Priority Queue is empty!" << endl;
+        return;
+    }
+
+    cout << "Priority Queue elements: ";
+    for (int v : pq.items())
+        cout << v << " ";
+    cout << endl;
+}
+
+// Main function
+// Build:  g++ -std=c++17 -O2 -march=native priority.cpp -o priority -pthread
+// Usage: ./priority              (menu)
+//        ./priority bench [n]
+//        ./priority bench-dary [max n]
+//        ./priority bench-batch [n] [k]
+//        ./priority bench-update [n] [ops]
+//        ./priority bench-radix [steps]
+//        ./priority bench-meld [workers] [keys per worker] [rounds]
+//        ./priority bench-concurrent [max threads] [ops per thread]
+//        ./priority rank-error [max threads] [n]
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "bench") {
+        runBenchmark(argc > 2 ? stoul(argv[2]) : 10000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "bench-dary") {
+        runAritySweep(argc > 2 ? stoul(argv[2]) : 100000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "bench-batch") {
+        size_t n = argc > 2 ? stoul(argv[2]) : 1000000;
+        runBatchBenchmark(n, min(n, argc > 3 ? stoul(argv[3]) : 1000));
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "bench-update") {
+        runUpdateBenchmark(argc > 2 ? stoul(argv[2]) : 1000000, argc > 3 ? stoul(argv[3]) : 10000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "bench-radix") {
+        runRadixBenchmark(argc > 2 ? stoul(argv[2]) : 10000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "bench-meld") {
+        runMeldBenchmark(argc > 2 ? stoul(argv[2]) : 16, argc > 3 ? stoul(argv[3]) : 10000,
+                         argc > 4 ? stoul(argv[4]) : 50);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "bench-concurrent") {
+        runConcurrentBenchmark(argc > 2 ? stoul(argv[2]) : 64, argc > 3 ? stoul(argv[3]) : 1000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "rank-error") {
+        runRankError(argc > 2 ? stoul(argv[2]) : 64, argc > 3 ? stoul(argv[3]) : 1000000);
+        return 0;
+    }
+
+    BinaryHeap<int> pq;
+    int choice, value;
+
+    while (1) {
+        cout << "\n--- Priority Queue Menu ---" << endl;
+        cout << "1. Insert" << endl;
+        cout << "2. Delete (highest priority)" << endl;
+        cout << "3. Display" << endl;
+        cout << "4. Exit" << endl;
+        cout << "Enter choice: ";
+        if (!(cin >> choice)) return 0;
+
+        switch (choice) {
+            case 1:
+                cout << "Enter value to insert: ";
+                cin >> value;
+                pq.push(value);
+                cout << "Inserted " << value << endl;
+                break;
+            case 2:
+                if (pq.tryPop(value))
+                    cout << "Deleted highest priority element: " << value << endl;
+                else
+                    cout << "Priority Queue is empty!" << endl;
+                break;
+            case 3:
+                display(pq);
+                break;
+            case 4:
+                exit(0);
+            default:
+                cout << "Invalid choice!" << endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,364 @@
+#ifndef PRIORITY_HEAP_HPP
+#define PRIORITY_HEAP_HPP
+
+#include <vector>
+#include <functional>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+#include <limits>
+#include <new>
+#include <cstdlib>
+#include <cassert>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Growable binary max-heap over any element type.
+ *
+ * Same ordering convention as std::priority_queue: with the default
+ * std::less, top() is the largest element. Storage is a std::vector, so the
+ * heap grows as needed and each object is an independent queue.
+ *
+ * Sift-up and sift-down use "hole moving": the element being placed is held
+ * aside while parents (or children) shift into the hole, and it is written
+ * once at its final position. That is one move per level instead of the
+ * three assignments of a swap. pop() additionally uses Floyd's bottom-up
+ * variant: the hole left at the root is walked all the way down to a leaf
+ * (one comparison per level, between the two children) and the last element
+ * is then sifted up from there, which usually takes only a step or two.
+ *
+ * Bulk loads should go through build_heap() or push_batch(), which heapify
+ * bottom-up in O(n) instead of paying O(log n) per push.
+ */
+template <typename T, typename Compare = std::less<T>>
+class BinaryHeap {
+public:
+    BinaryHeap() = default;
+    explicit BinaryHeap(Compare cmp) : cmp(std::move(cmp)) {}
+    explicit BinaryHeap(std::vector<T> values, Compare cmp = Compare()) : cmp(std::move(cmp)) {
+        build_heap(std::move(values));
+    }
+
+    bool empty() const { return data.empty(); }
+    size_t size() const { return data.size(); }
+    void reserve(size_t n) { data.reserve(n); }
+    void clear() { data.clear(); }
+
+    // Highest-priority element. Precondition: !empty()
+    const T& top() const {
+        assert(!data.empty());
+        return data.front();
+    }
+
+    void push(const T& value) {
+        data.push_back(value);
+        siftUp(data.size() - 1);
+    }
+
+    void push(T&& value) {
+        data.push_back(std::move(value));
+        siftUp(data.size() - 1);
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        data.emplace_back(std::forward<Args>(args)...);
+        siftUp(data.size() - 1);
+    }
+
+    // Removes and returns the highest-priority element. Precondition: !empty()
+    T pop() {
+        assert(!data.empty());
+        T result = std::move(data.front());
+        if (data.size() > 1) {
+            T last = std::move(data.back());
+            data.pop_back();
+            size_t hole = holeToLeaf(0, data.size());
+            data[hole] = std::move(last);
+            siftUp(hole);
+        } else {
+            data.pop_back();
+        }
+        return result;
+    }
+
+    // Out-of-band variant of pop(): returns false instead of a sentinel when empty
+    bool tryPop(T& out) {
+        if (data.empty()) return false;
+        out = pop();
+        return true;
+    }
+
+    // Replaces the contents with 'values', heapified bottom-up in O(n)
+    void build_heap(std::vector<T> values) {
+        data = std::move(values);
+        heapify();
+    }
+
+    // Adds a range of elements. A batch at least as large as the heap is
+    // appended and the whole array re-heapified (O(n + k)); a small batch is
+    // cheaper as k individual pushes (O(k log n)).
+    template <typename It>
+    void push_batch(It first, It last) {
+        size_t k = (size_t)std::distance(first, last);
+        if (k >= data.size()) {
+            data.insert(data.end(), first, last);
+            heapify();
+        } else {
+            data.reserve(data.size() + k);
+            for (; first != last; ++first) push(*first);
+        }
+    }
+
+    // Removes the k highest-priority elements (fewer if the heap is smaller)
+    // and returns them best first
+    std::vector<T> pop_k(size_t k) {
+        if (k > data.size()) k = data.size();
+        std::vector<T> out;
+        out.reserve(k);
+        for (size_t i = 0; i < k; i++) out.push_back(pop());
+        return out;
+    }
+
+    // Empties the heap into an array sorted worst to best (ascending for
+    // std::less). Each popped element goes into the slot the heap just gave
+    // up, so no extra memory is used.
+    std::vector<T> drain_sorted() {
+        for (size_t n = data.size(); n > 1; n--) {
+            T best = std::move(data[0]);
+            T last = std::move(data[n - 1]);
+            size_t hole = holeToLeaf(0, n - 1);
+            data[hole] = std::move(last);
+            siftUp(hole);
+            data[n - 1] = std::move(best);
+        }
+        return std::move(data);
+    }
+
+    // Elements in heap (array) order, for display
+    const std::vector<T>& items() const { return data; }
+
+private:
+    std::vector<T> data;
+    Compare cmp;
+
+    void siftUp(size_t i) {
+        T value = std::move(data[i]);
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (!cmp(data[parent], value)) break;
+            data[i] = std::move(data[parent]);
+            i = parent;
+        }
+        data[i] = std::move(value);
+    }
+
+    // Places data[i] into its subtree, moving higher-priority children up
+    void siftDown(size_t i) {
+        size_t n = data.size();
+        T value = std::move(data[i]);
+        size_t child;
+        while ((child = 2 * i + 1) < n) {
+            if (child + 1 < n && cmp(data[child], data[child + 1])) child++;
+            if (!cmp(value, data[child])) break;
+            data[i] = std::move(data[child]);
+            i = child;
+        }
+        data[i] = std::move(value);
+    }
+
+    // Floyd's heap construction: sift down every internal node, last first
+    void heapify() {
+        for (size_t i = data.size() / 2; i-- > 0;) siftDown(i);
+    }
+
+    // Moves the hole at i down to a leaf of the first n slots, promoting the
+    // larger child each step
+    size_t holeToLeaf(size_t i, size_t n) {
+        size_t child;
+        while ((child = 2 * i + 2) < n) {
+            if (cmp(data[child], data[child - 1])) child--;
+            data[i] = std::move(data[child]);
+            i = child;
+        }
+        if (child == n) { // Only a left child
+            data[i] = std::move(data[child - 1]);
+            i = child - 1;
+        }
+        return i;
+    }
+};
+
+// Sorts 'values' in place, ascending for std::less: O(n) heapify, then n pops
+template <typename T, typename Compare = std::less<T>>
+void heap_sort(std::vector<T>& values, Compare cmp = Compare()) {
+    BinaryHeap<T, Compare> heap(std::move(values), cmp);
+    values = heap.drain_sorted();
+}
+
+// The k highest-priority elements of 'values', best first. For small k a
+// k-element heap with the worst candidate on top filters the input in one
+// pass (O(n log k), mostly a single comparison per element); otherwise the
+// whole input is heapified in O(n) and k elements popped.
+template <typename T, typename Compare = std::less<T>>
+std::vector<T> partial_sort_top(const std::vector<T>& values, size_t k, Compare cmp = Compare()) {
+    if (k >= values.size() / 8) {
+        BinaryHeap<T, Compare> heap(values, cmp);
+        return heap.pop_k(k);
+    }
+    auto worseFirst = [cmp](const T& a, const T& b) { return cmp(b, a); };
+    BinaryHeap<T, decltype(worseFirst)> kept(std::vector<T>(values.begin(), values.begin() + k), worseFirst);
+    for (size_t i = k; i < values.size(); i++) {
+        if (k > 0 && cmp(kept.top(), values[i])) {
+            kept.pop();
+            kept.push(values[i]);
+        }
+    }
+    return kept.drain_sorted(); // Worst-first order under worseFirst: best first
+}
+
+// Minimal allocator returning memory aligned to 'Align' bytes
+template <typename T, size_t Align>
+struct AlignedAllocator {
+    using value_type = T;
+    template <typename U> struct rebind { using other = AlignedAllocator<U, Align>; };
+
+    AlignedAllocator() = default;
+    template <typename U> AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+    T* allocate(size_t n) {
+        size_t bytes = (n * sizeof(T) + Align - 1) / Align * Align;
+        void* p = std::aligned_alloc(Align, bytes);
+        if (p == nullptr) throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+    void deallocate(T* p, size_t) { std::free(p); }
+
+    template <typename U> bool operator==(const AlignedAllocator<U, Align>&) const { return true; }
+    template <typename U> bool operator!=(const AlignedAllocator<U, Align>&) const { return false; }
+};
+
+/**
+ * @brief D-ary max-heap whose sibling groups are aligned to cache lines.
+ *
+ * Logical node i has children D*i+1 .. D*i+D. Elements are stored shifted by
+ * D-1 slots in a 64-byte aligned buffer, which puts every sibling group at a
+ * multiple of D; when D * sizeof(T) divides 64, a group never straddles a
+ * cache line and sift-down takes one miss per level over log_D(n) levels
+ * instead of log_2(n).
+ *
+ * For int elements with std::less and D = 8 or 16, sift-down finds the
+ * largest child with AVX2 (full-group vector max, then compare + movemask).
+ * To keep that load valid for the last, partial group, slots past the end
+ * are kept filled with INT_MIN. Other instantiations use a scalar scan.
+ */
+template <typename T, size_t D = 4, typename Compare = std::less<T>>
+class DaryHeap {
+    static_assert(D >= 2, "a heap needs at least two children per node");
+
+public:
+    DaryHeap() { buf.assign(OFFSET + D, padValue()); }
+    explicit DaryHeap(Compare cmp) : cmp(std::move(cmp)) { buf.assign(OFFSET + D, padValue()); }
+
+    bool empty() const { return n == 0; }
+    size_t size() const { return n; }
+
+    void reserve(size_t count) { buf.reserve(OFFSET + count + D); }
+
+    // Highest-priority element. Precondition: !empty()
+    const T& top() const {
+        assert(n > 0);
+        return buf[OFFSET];
+    }
+
+    void push(T value) {
+        // Keep a whole padded group available past the last element
+        if (OFFSET + n + D >= buf.size()) buf.resize(OFFSET + (n + D) * 2, padValue());
+        size_t i = n++;
+        while (i > 0) {
+            size_t parent = (i - 1) / D;
+            if (!cmp(at(parent), value)) break;
+            at(i) = std::move(at(parent));
+            i = parent;
+        }
+        at(i) = std::move(value);
+    }
+
+    // Removes and returns the highest-priority element. Precondition: !empty()
+    T pop() {
+        assert(n > 0);
+        T result = std::move(at(0));
+        T last = std::move(at(n - 1));
+        at(n - 1) = padValue();
+        if (--n > 0) siftDown(0, std::move(last));
+        return result;
+    }
+
+private:
+    static constexpr size_t OFFSET = D - 1;
+    static constexpr bool SIMD_CHILDREN =
+#ifdef __AVX2__
+        std::is_same<T, int>::value && std::is_same<Compare, std::less<int>>::value && (D == 8 || D == 16);
+#else
+        false;
+#endif
+
+    std::vector<T, AlignedAllocator<T, 64>> buf;
+    size_t n = 0;
+    Compare cmp;
+
+    T& at(size_t i) { return buf[i + OFFSET]; }
+    const T& at(size_t i) const { return buf[i + OFFSET]; }
+
+    static T padValue() {
+        if constexpr (SIMD_CHILDREN) return std::numeric_limits<int>::min();
+        else return T();
+    }
+
+    // Index of the highest-priority child among first .. first+D-1
+    size_t bestChild(size_t first) const {
+#ifdef __AVX2__
+        if constexpr (SIMD_CHILDREN) {
+            const __m256i* group = reinterpret_cast<const __m256i*>(&buf[first + OFFSET]);
+            __m256i v = _mm256_load_si256(group);
+            if constexpr (D == 16) v = _mm256_max_epi32(v, _mm256_load_si256(group + 1));
+            __m256i m = _mm256_max_epi32(v, _mm256_permute2x128_si256(v, v, 1));
+            m = _mm256_max_epi32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+            m = _mm256_max_epi32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+            // m now holds the group maximum in every lane; locate its first occurrence
+            unsigned mask = (unsigned)_mm256_movemask_ps(
+                _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_load_si256(group), m)));
+            if constexpr (D == 16) {
+                unsigned hi = (unsigned)_mm256_movemask_ps(
+                    _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_load_si256(group + 1), m)));
+                mask |= hi << 8;
+            }
+            return first + (size_t)__builtin_ctz(mask);
+        }
+#endif
+        size_t last = first + D < n ? first + D : n;
+        size_t best = first;
+        for (size_t c = first + 1; c < last; c++)
+            if (cmp(at(best), at(c))) best = c;
+        return best;
+    }
+
+    // Places 'value' into the hole at i, moving larger children up into it
+    void siftDown(size_t i, T value) {
+        size_t first;
+        while ((first = D * i + 1) < n) {
+            size_t child = bestChild(first);
+            // Padding can win the SIMD max only if every real child is INT_MIN,
+            // in which case it does not beat 'value' either
+            if (child >= n || !cmp(value, at(child))) break;
+            at(i) = std::move(at(child));
+            i = child;
+        }
+        at(i) = std::move(value);
+    }
+};
+
+#endif // PRIORITY_HEAP_HPP
@@ -0,0 +1,116 @@
+#ifndef RADIX_HEAP_HPP
+#define RADIX_HEAP_HPP
+
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include <limits>
+#include <cstddef>
+#include <cassert>
+
+// Order policies for RadixHeap. MinFirst serves a clock that only moves
+// forward (pushed keys >= last popped key); MaxFirst serves a countdown
+// (pushed keys <= last popped key).
+struct MinFirst {};
+struct MaxFirst {};
+
+/**
+ * @brief Monotone radix heap for integer keys.
+ *
+ * Keys are mapped to unsigned integers in which the policy's "best" is the
+ * smallest. An element lives in bucket 0 if its key equals the last popped
+ * key, otherwise in bucket bit_width(key ^ last): the position of the
+ * highest bit where it differs from 'last'. Because keys never pass 'last',
+ * bucket b holds keys in [last, last + 2^b) and every lower bucket holds
+ * smaller keys.
+ *
+ * pop() serves bucket 0 directly. When it is empty, the lowest non-empty
+ * bucket is scanned for its minimum, which becomes 'last', and its elements
+ * are redistributed; each moves to a strictly lower bucket, so an element
+ * is moved at most bits(K) times. Pops thus cost amortized O(log C) bucket
+ * moves (C = key range) and no heap comparisons.
+ */
+template <typename K, typename V, typename Order = MinFirst>
+class RadixHeap {
+    static_assert(std::is_integral<K>::value, "radix heaps need integer keys");
+    using U = typename std::make_unsigned<K>::type;
+    static constexpr int BITS = std::numeric_limits<U>::digits;
+
+public:
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    // Precondition: key does not precede the last popped key under Order
+    void push(K key, V value) {
+        U u = encode(key);
+        assert(u >= last && "radix heap keys must be monotone");
+        buckets[bucketOf(u)].emplace_back(u, std::move(value));
+        count++;
+    }
+
+    // Key of the best element. Precondition: !empty()
+    K topKey() {
+        refill();
+        return decode(buckets[0].back().first);
+    }
+
+    // Removes and returns the best element. Precondition: !empty()
+    std::pair<K, V> pop() {
+        refill();
+        auto& b0 = buckets[0];
+        std::pair<K, V> result(decode(b0.back().first), std::move(b0.back().second));
+        b0.pop_back();
+        count--;
+        return result;
+    }
+
+    void clear() {
+        for (auto& b : buckets) b.clear();
+        count = 0;
+        last = 0;
+    }
+
+private:
+    std::vector<std::pair<U, V>> buckets[BITS + 1];
+    size_t count = 0;
+    U last = 0;
+
+    // Signed keys flip the sign bit so that unsigned order matches; MaxFirst
+    // complements, turning the largest key into the smallest
+    static U encode(K key) {
+        U u = (U)key;
+        if (std::is_signed<K>::value) u ^= (U)1 << (BITS - 1);
+        if (std::is_same<Order, MaxFirst>::value) u = (U)~u;
+        return u;
+    }
+    static K decode(U u) {
+        if (std::is_same<Order, MaxFirst>::value) u = (U)~u;
+        if (std::is_signed<K>::value) u ^= (U)1 << (BITS - 1);
+        return (K)u;
+    }
+
+    int bucketOf(U u) const {
+        U diff = u ^ last;
+        if (diff == 0) return 0;
+        if constexpr (sizeof(U) <= sizeof(unsigned)) return BITS - (__builtin_clz((unsigned)diff) - (32 - BITS));
+        return 64 - __builtin_clzll((unsigned long long)diff);
+    }
+
+    // Makes bucket 0 non-empty by advancing 'last' to the current minimum
+    void refill() {
+        assert(count > 0);
+        if (!buckets[0].empty()) return;
+        int b = 1;
+        while (buckets[b].empty()) b++;
+
+        U least = buckets[b][0].first;
+        for (auto& e : buckets[b])
+            if (e.first < least) least = e.first;
+        last = least;
+
+        for (auto& e : buckets[b]) buckets[bucketOf(e.first)].push_back(std::move(e));
+        buckets[b].clear();
+    }
+};
+
+#endif // RADIX_HEAP_HPP
@@ -0,0 +1,213 @@
+#ifndef SIMD_MERGE_H
+#define SIMD_MERGE_H
+
+// Merge kernels for sorted int32/int64 arrays, shared by merge.c and
+// parallel_sort.hpp.
+//
+// A scalar merge takes one data-dependent branch per output element, which
+// mispredicts about half the time on random data. mergeBranchless32/64 turn
+// that branch into arithmetic on the two indices. mergeInt32/64 go further
+// with AVX2 (-mavx2 or -march=native): both inputs are consumed in vector
+// blocks (8 x int32 or 4 x int64) and each new block is merged against the
+// carried-over largest block with a bitonic merge network (one min/max
+// layer, then log2(width) in-register shuffle steps). The only remaining
+// branch decision, which input supplies the next block, is made once per
+// block and compiled to conditional moves. Without AVX2 they fall back to
+// the branchless scalar kernels.
+//
+// The vector kernels do not preserve the order of equal keys, which is
+// invisible for plain integer keys.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// --- Scalar Kernels ---
+
+static inline void mergeBranchless32(const int32_t *a, size_t na, const int32_t *b, size_t nb, int32_t *out) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        int takeB = b[j] < a[i];
+        out[k++] = takeB ? b[j] : a[i];
+        j += takeB;
+        i += !takeB;
+    }
+    while (i < na) out[k++] = a[i++];
+    while (j < nb) out[k++] = b[j++];
+}
+
+static inline void mergeBranchless64(const int64_t *a, size_t na, const int64_t *b, size_t nb, int64_t *out) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        int takeB = b[j] < a[i];
+        out[k++] = takeB ? b[j] : a[i];
+        j += takeB;
+        i += !takeB;
+    }
+    while (i < na) out[k++] = a[i++];
+    while (j < nb) out[k++] = b[j++];
+}
+
+#ifdef __AVX2__
+
+// --- AVX2 Bitonic Networks ---
+
+// Merges sorted vectors *lo and *hi: afterwards *lo holds the 8 smallest
+// keys in order and *hi the 8 largest
+static inline void bitonicMerge8x32(__m256i *lo, __m256i *hi) {
+    __m256i b = _mm256_permutevar8x32_epi32(*hi, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    __m256i l = _mm256_min_epi32(*lo, b);
+    __m256i h = _mm256_max_epi32(*lo, b);
+    // Both halves are now bitonic; sort each with distance 4, 2, 1 steps
+    __m256i t, mn, mx;
+    t = _mm256_permute2x128_si256(l, l, 1);
+    mn = _mm256_min_epi32(l, t); mx = _mm256_max_epi32(l, t);
+    l = _mm256_blend_epi32(mn, mx, 0xF0);
+    t = _mm256_permute2x128_si256(h, h, 1);
+    mn = _mm256_min_epi32(h, t); mx = _mm256_max_epi32(h, t);
+    h = _mm256_blend_epi32(mn, mx, 0xF0);
+
+    t = _mm256_shuffle_epi32(l, _MM_SHUFFLE(1, 0, 3, 2));
+    mn = _mm256_min_epi32(l, t); mx = _mm256_max_epi32(l, t);
+    l = _mm256_blend_epi32(mn, mx, 0xCC);
+    t = _mm256_shuffle_epi32(h, _MM_SHUFFLE(1, 0, 3, 2));
+    mn = _mm256_min_epi32(h, t); mx = _mm256_max_epi32(h, t);
+    h = _mm256_blend_epi32(mn, mx, 0xCC);
+
+    t = _mm256_shuffle_epi32(l, _MM_SHUFFLE(2, 3, 0, 1));
+    mn = _mm256_min_epi32(l, t); mx = _mm256_max_epi32(l, t);
+    l = _mm256_blend_epi32(mn, mx, 0xAA);
+    t = _mm256_shuffle_epi32(h, _MM_SHUFFLE(2, 3, 0, 1));
+    mn = _mm256_min_epi32(h, t); mx = _mm256_max_epi32(h, t);
+    h = _mm256_blend_epi32(mn, mx, 0xAA);
+
+    *lo = l;
+    *hi = h;
+}
+
+// AVX2 has no 64-bit min/max; one compare and an xor-swap replace them
+static inline void minMax4x64(__m256i x, __m256i y, __m256i *mn, __m256i *mx) {
+    __m256i d = _mm256_and_si256(_mm256_xor_si256(x, y), _mm256_cmpgt_epi64(x, y));
+    *mn = _mm256_xor_si256(x, d);
+    *mx = _mm256_xor_si256(y, d);
+}
+
+// One compare-exchange step of a bitonic sort on x against its partner
+// lanes t: lanes set in upper take the larger key, the rest the smaller.
+// Partners compare in opposite directions, so a single cmpgt, flipped in
+// the upper lanes, selects for both (on a tie either choice is right).
+static inline __m256i exchange4x64(__m256i x, __m256i t, __m256i upper) {
+    __m256i take = _mm256_xor_si256(_mm256_cmpgt_epi64(x, t), upper);
+    return _mm256_xor_si256(x, _mm256_and_si256(_mm256_xor_si256(x, t), take));
+}
+
+// 4 x int64 counterpart of bitonicMerge8x32
+static inline void bitonicMerge4x64(__m256i *lo, __m256i *hi) {
+    const __m256i upper2 = _mm256_setr_epi64x(0, 0, -1, -1);
+    const __m256i upper1 = _mm256_setr_epi64x(0, -1, 0, -1);
+    __m256i b = _mm256_permute4x64_epi64(*hi, _MM_SHUFFLE(0, 1, 2, 3));
+    __m256i l, h;
+    minMax4x64(*lo, b, &l, &h);
+
+    l = exchange4x64(l, _mm256_permute4x64_epi64(l, _MM_SHUFFLE(1, 0, 3, 2)), upper2);
+    h = exchange4x64(h, _mm256_permute4x64_epi64(h, _MM_SHUFFLE(1, 0, 3, 2)), upper2);
+    l = exchange4x64(l, _mm256_shuffle_epi32(l, _MM_SHUFFLE(1, 0, 3, 2)), upper1);
+    h = exchange4x64(h, _mm256_shuffle_epi32(h, _MM_SHUFFLE(1, 0, 3, 2)), upper1);
+
+    *lo = l;
+    *hi = h;
+}
+
+#endif // __AVX2__
+
+// --- Merge Entry Points ---
+
+/**
+ * Merges sorted a[0..na) and sorted b[0..nb) into out (na + nb keys).
+ * The vector loop runs while both inputs have a full block left; the
+ * carried block of largest keys is then merged with the shorter remainder
+ * on the stack, and that result with the longer remainder, branchlessly.
+ */
+static inline void mergeInt32(const int32_t *a, size_t na, const int32_t *b, size_t nb, int32_t *out) {
+#ifdef __AVX2__
+    if (na >= 8 && nb >= 8) {
+        const int32_t *aEnd = a + na, *bEnd = b + nb;
+        __m256i lo = _mm256_loadu_si256((const __m256i *)a);
+        __m256i hi = _mm256_loadu_si256((const __m256i *)b);
+        a += 8;
+        b += 8;
+        bitonicMerge8x32(&lo, &hi);
+        _mm256_storeu_si256((__m256i *)out, lo);
+        out += 8;
+
+        while (aEnd - a >= 8 && bEnd - b >= 8) {
+            // The input with the smaller head supplies the next block
+            int fromA = *a <= *b;
+            const int32_t *src = fromA ? a : b;
+            a += fromA ? 8 : 0;
+            b += fromA ? 0 : 8;
+            lo = _mm256_loadu_si256((const __m256i *)src);
+            bitonicMerge8x32(&lo, &hi);
+            _mm256_storeu_si256((__m256i *)out, lo);
+            out += 8;
+        }
+
+        int32_t carried[8], tail[16];
+        _mm256_storeu_si256((__m256i *)carried, hi);
+        size_t ra = (size_t)(aEnd - a), rb = (size_t)(bEnd - b);
+        if (ra < 8) {
+            mergeBranchless32(carried, 8, a, ra, tail);
+            mergeBranchless32(tail, 8 + ra, b, rb, out);
+        } else {
+            mergeBranchless32(carried, 8, b, rb, tail);
+            mergeBranchless32(tail, 8 + rb, a, ra, out);
+        }
+        return;
+    }
+#endif
+    mergeBranchless32(a, na, b, nb, out);
+}
+
+static inline void mergeInt64(const int64_t *a, size_t na, const int64_t *b, size_t nb, int64_t *out) {
+#ifdef __AVX2__
+    if (na >= 4 && nb >= 4) {
+        const int64_t *aEnd = a + na, *bEnd = b + nb;
+        __m256i lo = _mm256_loadu_si256((const __m256i *)a);
+        __m256i hi = _mm256_loadu_si256((const __m256i *)b);
+        a += 4;
+        b += 4;
+        bitonicMerge4x64(&lo, &hi);
+        _mm256_storeu_si256((__m256i *)out, lo);
+        out += 4;
+
+        while (aEnd - a >= 4 && bEnd - b >= 4) {
+            int fromA = *a <= *b;
+            const int64_t *src = fromA ? a : b;
+            a += fromA ? 4 : 0;
+            b += fromA ? 0 : 4;
+            lo = _mm256_loadu_si256((const __m256i *)src);
+            bitonicMerge4x64(&lo, &hi);
+            _mm256_storeu_si256((__m256i *)out, lo);
+            out += 4;
+        }
+
+        int64_t carried[4], tail[8];
+        _mm256_storeu_si256((__m256i *)carried, hi);
+        size_t ra = (size_t)(aEnd - a), rb = (size_t)(bEnd - b);
+        if (ra < 4) {
+            mergeBranchless64(carried, 4, a, ra, tail);
+            mergeBranchless64(tail, 4 + ra, b, rb, out);
+        } else {
+            mergeBranchless64(carried, 4, b, rb, tail);
+            mergeBranchless64(tail, 4 + rb, a, ra, out);
+        }
+        return;
+    }
+#endif
+    mergeBranchless64(a, na, b, nb, out);
+}
+
+#endif // SIMD_MERGE_H
@@ -0,0 +1,150 @@
+#ifndef WORK_STEALING_HPP
+#define WORK_STEALING_HPP
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <cstdint>
+
+// Counts the outstanding tasks of one fork-join scope
+struct TaskGroup {
+    std::atomic<size_t> pending{0};
+};
+
+/**
+ * @brief Fork-join thread pool with per-worker deques and work stealing.
+ *
+ * spawn() pushes onto the calling worker's own deque; a worker pops its own
+ * deque from the back (newest, smallest subproblem, still hot in cache) and,
+ * when empty, steals from the front of a random victim (oldest, largest
+ * subproblem). wait() never blocks while there is work: the waiting thread
+ * keeps running its own or stolen tasks until its group is done, so nested
+ * spawn/wait recursion cannot deadlock the pool.
+ *
+ * run() makes the calling thread worker 0 for the duration of one root task;
+ * a pool of T threads therefore starts T - 1 background workers.
+ */
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(size_t threads) : queues(threads < 1 ? 1 : threads) {
+        for (size_t i = 1; i < queues.size(); i++) workers.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    size_t threadCount() const { return queues.size(); }
+
+    // Runs 'root' on the calling thread, which helps with spawned tasks
+    // until they are all finished
+    void run(const std::function<void()>& root) {
+        int saved = self;
+        self = 0;
+        root();
+        self = saved;
+    }
+
+    void spawn(TaskGroup& group, std::function<void()> fn) {
+        group.pending.fetch_add(1, std::memory_order_relaxed);
+        Queue& q = queues[self < 0 ? 0 : (size_t)self];
+        {
+            std::lock_guard<std::mutex> guard(q.lock);
+            q.tasks.push_back(Task{std::move(fn), &group});
+        }
+        queued.fetch_add(1);
+        if (sleeping.load() > 0) {
+            // Taking the lock orders this notify after a sleeper's predicate check
+            std::lock_guard<std::mutex> guard(sleepLock);
+            wake.notify_one();
+        }
+    }
+
+    // Returns once every task spawned into 'group' (and their children's
+    // waits) has finished, running other tasks in the meantime
+    void wait(TaskGroup& group) {
+        while (group.pending.load(std::memory_order_acquire) != 0)
+            if (!runOne()) std::this_thread::yield();
+    }
+
+private:
+    struct Task {
+        std::function<void()> fn;
+        TaskGroup* group;
+    };
+    struct alignas(64) Queue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<Queue> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0};
+    std::atomic<size_t> sleeping{0};
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    static inline thread_local int self = -1;
+
+    bool popOwn(Task& out) {
+        Queue& q = queues[self < 0 ? 0 : (size_t)self];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (q.tasks.empty()) return false;
+        out = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(Task& out) {
+        static thread_local uint64_t state = 0;
+        if (state == 0) state = (uint64_t)(uintptr_t)&state * 0x9e3779b97f4a7c15ULL | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        size_t n = queues.size();
+        size_t start = (size_t)(state % n);
+        for (size_t k = 0; k < n; k++) {
+            Queue& q = queues[(start + k) % n];
+            std::unique_lock<std::mutex> guard(q.lock, std::try_to_lock);
+            if (!guard.owns_lock() || q.tasks.empty()) continue;
+            out = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    bool runOne() {
+        Task task;
+        if (!popOwn(task) && !steal(task)) return false;
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        task.fn();
+        task.group->pending.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    void workerLoop(size_t index) {
+        self = (int)index;
+        for (;;) {
+            if (runOne()) continue;
+            std::unique_lock<std::mutex> guard(sleepLock);
+            if (stopping) return;
+            sleeping.fetch_add(1);
+            wake.wait(guard, [this] { return stopping || queued.load() != 0; });
+            sleeping.fetch_sub(1);
+        }
+    }
+};
+
+#endif // WORK_STEALING_HPP
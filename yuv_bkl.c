@@ -1,103 +1,182 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
-
-// Function to add two matrices
-void addMatrix(int n, int A[n][n], int B[n][n], int C[n][n]) {
-    for (int i = 0; i < n; i++)
-        for (int j = 0; j < n; j++)
-            C[i][j] = A[i][j] + B[i][j];
-}
-
-// Function to subtract two matrices
-void subMatrix(int n, int A[n][n], int B[n][n], int C[n][n]) {
-    for (int i = 0; i < n; i++)
-        for (int j = 0; j < n; j++)
-            C[i][j] = A[i][j] - B[i][j];
-}
-
-// Recursive function to multiply matrices using divide and conquer
-void multiplyMatrix(int n, int A[n][n], int B[n][n], int C[n][n]) {
-    if (n == 1) {
-        C[0][0] = A[0][0] * B[0][0];
+#include <string.h>
+#include <time.h>
+#include "gemm.h"
+
+#define LEAF 128 // Subproblems with a dimension this small go to the packed GEMM kernel
+
+// Recursive function to multiply an m x k matrix A by a k x n matrix B
+// using divide and conquer: C = A * B, or C += A * B when 'accumulate' is
+// set. Matrices are row-major with leading dimensions lda, ldb and ldc, so
+// a quadrant is just a pointer into its parent plus the parent's leading
+// dimension: nothing is copied. Each C quadrant takes its first product
+// directly and accumulates the second into it, so no temporaries are
+// needed either. Any sizes work: each dimension is split into halves that
+// differ by at most one (m1 = m / 2 rows on top, m2 = m - m1 below, and
+// likewise for k and n), so nothing is padded.
+void multiplyMatrix(int m, int k, int n, const int *A, int lda, const int *B, int ldb,
+                    int *C, int ldc, int accumulate) {
+    if (m <= LEAF || k <= LEAF || n <= LEAF) {
+        gemmInt32(m, n, k, A, lda, B, ldb, C, ldc, accumulate);
         return;
     }
 
-    int k = n / 2;
-    int A11[k][k], A12[k][k], A21[k][k], A22[k][k];
-    int B11[k][k], B12[k][k], B21[k][k], B22[k][k];
-    int C11[k][k], C12[k][k], C21[k][k], C22[k][k];
-    int temp1[k][k], temp2[k][k];
-
-    // Divide matrices into 4 submatrices
-    for (int i = 0; i < k; i++) {
-        for (int j = 0; j < k; j++) {
-            A11[i][j] = A[i][j];
-            A12[i][j] = A[i][j + k];
-            A21[i][j] = A[i + k][j];
-            A22[i][j] = A[i + k][j + k];
-            B11[i][j] = B[i][j];
-            B12[i][j] = B[i][j + k];
-            B21[i][j] = B[i + k][j];
-            B22[i][j] = B[i + k][j + k];
-        }
-    }
+    int m1 = m / 2, m2 = m - m1;
+    int k1 = k / 2, k2 = k - k1;
+    int n1 = n / 2, n2 = n - n1;
+
+    // Views of the 4 submatrices of each matrix
+    const int *A11 = A, *A12 = A + k1, *A21 = A + (size_t)m1 * lda, *A22 = A21 + k1;
+    const int *B11 = B, *B12 = B + n1, *B21 = B + (size_t)k1 * ldb, *B22 = B21 + n1;
+    int *C11 = C, *C12 = C + n1, *C21 = C + (size_t)m1 * ldc, *C22 = C21 + n1;
 
     // C11 = A11*B11 + A12*B21
-    multiplyMatrix(k, A11, B11, temp1);
-    multiplyMatrix(k, A12, B21, temp2);
-    addMatrix(k, temp1, temp2, C11);
+    multiplyMatrix(m1, k1, n1, A11, lda, B11, ldb, C11, ldc, accumulate);
+    multiplyMatrix(m1, k2, n1, A12, lda, B21, ldb, C11, ldc, 1);
 
     // C12 = A11*B12 + A12*B22
-    multiplyMatrix(k, A11, B12, temp1);
-    multiplyMatrix(k, A12, B22, temp2);
-    addMatrix(k, temp1, temp2, C12);
+    multiplyMatrix(m1, k1, n2, A11, lda, B12, ldb, C12, ldc, accumulate);
+    multiplyMatrix(m1, k2, n2, A12, lda, B22, ldb, C12, ldc, 1);
 
     // C21 = A21*B11 + A22*B21
-    multiplyMatrix(k, A21, B11, temp1);
-    multiplyMatrix(k, A22, B21, temp2);
-    addMatrix(k, temp1, temp2, C21);
+    multiplyMatrix(m2, k1, n1, A21, lda, B11, ldb, C21, ldc, accumulate);
+    multiplyMatrix(m2, k2, n1, A22, lda, B21, ldb, C21, ldc, 1);
 
     // C22 = A21*B12 + A22*B22
-    multiplyMatrix(k, A21, B12, temp1);
-    multiplyMatrix(k, A22, B22, temp2);
-    addMatrix(k, temp1, temp2, C22);
-
-    // Combine results into C
-    for (int i = 0; i < k; i++) {
-        for (int j = 0; j < k; j++) {
-            C[i][j] = C11[i][j];
-            C[i][j + k] = C12[i][j];
-            C[i + k][j] = C21[i][j];
-            C[i + k][j + k] = C22[i][j];
+    multiplyMatrix(m2, k1, n2, A21, lda, B12, ldb, C22, ldc, accumulate);
+    multiplyMatrix(m2, k2, n2, A22, lda, B22, ldb, C22, ldc, 1);
+}
+
+// --- Verification ---
+
+static unsigned long long rngState = 88172645463325252ULL;
+static int nextKey(void) {
+    rngState ^= rngState << 13; rngState ^= rngState >> 7; rngState ^= rngState << 17;
+    return (int)(rngState & 0x7fffffff);
+}
+
+// Multiplies random matrices of 'trials' random shapes (each dimension
+// 1..maxDim) and compares every entry with a naive triple loop
+int runVerify(int trials, int maxDim) {
+    int failures = 0;
+    printf("--- Divide and conquer vs naive reference, %d random shapes up to %d ---\n", trials, maxDim);
+    for (int t = 0; t < trials; t++) {
+        int m = 1 + nextKey() % maxDim, k = 1 + nextKey() % maxDim, n = 1 + nextKey() % maxDim;
+        int (*A)[k] = malloc(sizeof(int[m][k]));
+        int (*B)[n] = malloc(sizeof(int[k][n]));
+        int (*C)[n] = malloc(sizeof(int[m][n]));
+        if (A == NULL || B == NULL || C == NULL) {
+            printf("Memory allocation failed!\n");
+            exit(1);
+        }
+        for (int i = 0; i < m; i++)
+            for (int j = 0; j < k; j++) A[i][j] = nextKey() % 19 - 9;
+        for (int i = 0; i < k; i++)
+            for (int j = 0; j < n; j++) B[i][j] = nextKey() % 19 - 9;
+
+        multiplyMatrix(m, k, n, &A[0][0], k, &B[0][0], n, &C[0][0], n, 0);
+
+        int ok = 1;
+        for (int i = 0; i < m && ok; i++)
+            for (int j = 0; j < n; j++) {
+                int sum = 0;
+                for (int x = 0; x < k; x++) sum += A[i][x] * B[x][j];
+                if (sum != C[i][j]) {
+                    ok = 0;
+                    break;
+                }
+            }
+        if (!ok) {
+            printf("  MISMATCH for %d x %d by %d x %d\n", m, k, k, n);
+            failures++;
         }
+        free(A);
+        free(B);
+        free(C);
     }
+    printf("%d of %d shapes correct\n", trials - failures, trials);
+    return failures;
 }
 
-int main() {
-    int n;
-    printf("Enter size of square matrix (power of 2): ");
-    scanf("%d", &n);
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
 
-    int A[n][n], B[n][n], C[n][n];
+// Times n x n multiplies for n = 256 ... maxN. The recursion neither copies
+// quadrants nor allocates temporaries, so all data movement is GEMM's own
+// packing; sizes are no longer limited by the stack.
+void runBenchmark(int maxN) {
+    printf("--- Divide and conquer over strided views ---\n");
+    printf("%8s %12s %10s\n", "n", "time (s)", "GFLOP/s");
+    for (int n = 256; n <= maxN; n *= 2) {
+        int *A = malloc(sizeof(int) * n * n), *B = malloc(sizeof(int) * n * n), *C = malloc(sizeof(int) * n * n);
+        if (A == NULL || B == NULL || C == NULL) {
+            printf("Memory allocation failed!\n");
+            exit(1);
+        }
+        for (size_t x = 0; x < (size_t)n * n; x++) {
+            A[x] = nextKey() % 19 - 9;
+            B[x] = nextKey() % 19 - 9;
+        }
+        double start = nowSeconds();
+        multiplyMatrix(n, n, n, A, n, B, n, C, n, 0);
+        double elapsed = nowSeconds() - start;
+        printf("%8d %12.3f %10.2f\n", n, elapsed, 2.0 * n * n * (double)n / elapsed / 1e9);
+        free(A);
+        free(B);
+        free(C);
+    }
+}
+
+// Build:  gcc -O2 -march=native yuv_bkl.c -o yuv_bkl
+// Usage: ./yuv_bkl                              (interactive)
+//        ./yuv_bkl verify [trials] [max dimension]
+//        ./yuv_bkl bench [max n]
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "verify") == 0)
+        return runVerify(argc > 2 ? atoi(argv[2]) : 100, argc > 3 ? atoi(argv[3]) : 1000) > 0;
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        runBenchmark(argc > 2 ? atoi(argv[2]) : 4096);
+        return 0;
+    }
+
+    int m, k, n;
+    printf("Enter dimensions m k n (first matrix is m x k, second is k x n): ");
+    if (scanf("%d %d %d", &m, &k, &n) != 3 || m < 1 || k < 1 || n < 1) return 1;
+
+    int (*A)[k] = malloc(sizeof(int[m][k]));
+    int (*B)[n] = malloc(sizeof(int[k][n]));
+    int (*C)[n] = malloc(sizeof(int[m][n]));
+    if (A == NULL || B == NULL || C == NULL) {
+        printf("Memory allocation failed!\n");
+        return 1;
+    }
 
     printf("Enter elements of first matrix:\n");
-    for (int i = 0; i < n; i++)
-        for (int j = 0; j < n; j++)
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < k; j++)
             scanf("%d", &A[i][j]);
 
     printf("Enter elements of second matrix:\n");
-    for (int i = 0; i < n; i++)
+    for (int i = 0; i < k; i++)
         for (int j = 0; j < n; j++)
             scanf("%d", &B[i][j]);
 
-    multiplyMatrix(n, A, B, C);
+    multiplyMatrix(m, k, n, &A[0][0], k, &B[0][0], n, &C[0][0], n, 0);
 
     printf("Resultant matrix:\n");
-    for (int i = 0; i < n; i++) {
+    for (int i = 0; i < m; i++) {
         for (int j = 0; j < n; j++)
             printf("%d ", C[i][j]);
         printf("\n");
     }
 
+    free(A);
+    free(B);
+    free(C);
     return 0;
 }